@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "core/bitboard_game.hpp"
+#include "core/game.hpp"
+#include "core/random.hpp"
+#include "core/settings.hpp"
+
+/**
+ * Plays the same seeded games on Game and BitboardGame, with easy dig and easy flag on, and checks both agree on the
+ * layout, the revealed cells, the flags and the outcome after every move. Reports the time both spend in their moves
+ * and the memory their boards take.
+ */
+
+using Clock = std::chrono::steady_clock;
+using GridCoords = Game::GridCoords;
+
+struct Board {
+    const char *name;
+    int rows;
+    int columns;
+    int mines;
+    int games;
+};
+
+static constexpr Board BOARDS[] = {
+    {"Huge", 27, 48, 220, 500},
+    {"Crowded", 16, 16, 200, 500},
+    {"256 x 256", 256, 256, 10000, 10},
+};
+
+// Out of 10 moves, the rest reveal any cell, which may be a mine or a chord on a revealed number
+static constexpr int SAFE_REVEAL_MOVES = 6;
+static constexpr int FLAG_MOVES = 2;
+
+struct Timings {
+    double game_ms = 0;
+    double bitboard_ms = 0;
+};
+
+static double elapsed_ms(const Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static std::vector<GridCoords> sorted(std::vector<GridCoords> cells) {
+    std::sort(cells.begin(), cells.end(), [](const GridCoords &a, const GridCoords &b) {
+        return a.y != b.y ? a.y < b.y : a.x < b.x;
+    });
+    return cells;
+}
+
+static bool agree(const Game &game, const BitboardGame &bitboard) {
+    if (game.get_remaining_mines() != bitboard.get_remaining_mines()
+        || game.is_over() != bitboard.is_over()
+        || game.has_won() != bitboard.has_won())
+        return false;
+
+    for (int y = 0; y < game.get_rows(); y++)
+        for (int x = 0; x < game.get_columns(); x++) {
+            const Game::GridCell &cell = game.get_grid_cell(x, y);
+            const Game::GridCell bitboard_cell = bitboard.get_grid_cell(x, y);
+
+            if (cell.type != bitboard_cell.type
+                || cell.revealed != bitboard_cell.revealed
+                || cell.flagged != bitboard_cell.flagged)
+                return false;
+        }
+
+    return true;
+}
+
+static bool agree(const std::vector<GridCoords> &revealed, const std::vector<GridCoords> &bitboard_revealed) {
+    if (revealed.size() != bitboard_revealed.size())
+        return false;
+
+    const std::vector<GridCoords> cells = sorted(revealed);
+    const std::vector<GridCoords> bitboard_cells = sorted(bitboard_revealed);
+
+    for (size_t i = 0; i < cells.size(); i++)
+        if (cells[i].x != bitboard_cells[i].x || cells[i].y != bitboard_cells[i].y)
+            return false;
+
+    return true;
+}
+
+/**
+ * Moves are picked from the Game, so both boards get the same ones as long as they agree
+ */
+static bool play(const Board &board, const uint64_t seed, Timings &timings) {
+    Game game(board.rows, board.columns, board.mines, seed);
+    // Seeded when placing the mines, replaying the Game's seed
+    BitboardGame bitboard(board.rows, board.columns, board.mines);
+    CounterRandom random(CounterRandom::mix(~seed));
+
+    const int first_x = random.uniform(0, board.columns - 1);
+    const int first_y = random.uniform(0, board.rows - 1);
+
+    Clock::time_point start = Clock::now();
+    game.place_grid_mines(first_x, first_y);
+    game.reveal_cell(first_x, first_y);
+    timings.game_ms += elapsed_ms(start);
+
+    start = Clock::now();
+    bitboard.place_grid_mines(first_x, first_y, game.get_seed());
+    bitboard.reveal_cell(first_x, first_y);
+    timings.bitboard_ms += elapsed_ms(start);
+
+    if (!agree(game, bitboard))
+        return false;
+
+    while (!game.is_over()) {
+        const int move = random.uniform(0, 9);
+        int x, y;
+
+        do {
+            x = random.uniform(0, board.columns - 1);
+            y = random.uniform(0, board.rows - 1);
+        } while (move < SAFE_REVEAL_MOVES && (game.get_grid_cell(x, y).type == Game::CELL_MINE
+            || game.get_grid_cell(x, y).revealed
+            || game.get_grid_cell(x, y).flagged));
+
+        if (move >= SAFE_REVEAL_MOVES && move < SAFE_REVEAL_MOVES + FLAG_MOVES) {
+            start = Clock::now();
+            game.toggle_cell_flag(x, y);
+            timings.game_ms += elapsed_ms(start);
+
+            start = Clock::now();
+            bitboard.toggle_cell_flag(x, y);
+            timings.bitboard_ms += elapsed_ms(start);
+        } else {
+            start = Clock::now();
+            const std::vector<GridCoords> &revealed = game.reveal_cell(x, y);
+            timings.game_ms += elapsed_ms(start);
+
+            start = Clock::now();
+            const std::vector<GridCoords> &bitboard_revealed = bitboard.reveal_cell(x, y);
+            timings.bitboard_ms += elapsed_ms(start);
+
+            if (!agree(revealed, bitboard_revealed))
+                return false;
+        }
+
+        if (!agree(game, bitboard))
+            return false;
+    }
+
+    return true;
+}
+
+int main() {
+    using std::cout;
+    using std::setw;
+
+    Settings::toggle(Settings::EASY_DIG);
+    Settings::toggle(Settings::EASY_FLAG);
+
+    cout << std::left << setw(12) << "board" << std::right << setw(8) << "games" << setw(12) << "Game (ms)"
+            << setw(16) << "Bitboard (ms)" << setw(14) << "Game (KiB)" << setw(18) << "Bitboard (KiB)" << std::endl;
+
+    for (const Board &board : BOARDS) {
+        Timings timings;
+
+        for (int i = 0; i < board.games; i++) {
+            if (play(board, i, timings))
+                continue;
+
+            std::cerr << board.name << ": Game and BitboardGame disagree with seed " << i << std::endl;
+            return 1;
+        }
+
+        const BitboardGame bitboard(board.rows, board.columns, board.mines);
+        const size_t game_memory = static_cast<size_t>(board.rows + 2) * (board.columns + 2) * sizeof(Game::GridCell);
+
+        cout << std::left << setw(12) << board.name << std::right << setw(8) << board.games
+                << std::fixed << std::setprecision(2)
+                << setw(12) << timings.game_ms
+                << setw(16) << timings.bitboard_ms
+                << setw(14) << game_memory / 1024.0
+                << setw(18) << bitboard.get_memory_usage() / 1024.0 << std::endl;
+    }
+
+    return 0;
+}
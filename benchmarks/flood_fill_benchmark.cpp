@@ -0,0 +1,175 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "core/game.hpp"
+#include "core/random.hpp"
+
+/**
+ * Compares Game::reveal_cell against the recursive flood fill it replaced.
+ * Timed boards are mine free, so a single click opens the whole grid, which is the worst case for both.
+ * Before timing, both fills open seeded boards with mines and must reveal the same cells, so a fill that crosses
+ * numbered cells or misses a region is caught.
+ */
+
+using Clock = std::chrono::steady_clock;
+using GridCell = Game::GridCell;
+
+// Deeper recursions overflow a default 8 MiB stack
+static constexpr int RECURSIVE_MAX_CELLS = 1 << 16;
+static constexpr int BOARD_SIDES[] = {64, 256, 512, 1024, 2048, 4096};
+static constexpr int MINED_BOARD_SIDE = 128;
+static constexpr int MINED_BOARD_DENSITIES[] = {5, 10, 15, 20, 25};
+static constexpr int MINED_BOARD_SEEDS = 50;
+
+/**
+ * Reference copy of the recursive reveal_cells_dfs/reveal_cell_border pair
+ */
+class RecursiveFloodFill {
+    std::vector<GridCell> m_grid;
+    int m_stride;
+    int m_offsets[8];
+    int m_unrevealed_count;
+
+public:
+    explicit RecursiveFloodFill(const Game &game) :
+        m_stride(game.get_columns() + 2),
+        m_offsets{
+            -m_stride - 1, -m_stride, -m_stride + 1,
+            -1, 1,
+            m_stride - 1, m_stride, m_stride + 1,
+        },
+        m_unrevealed_count(game.get_rows() * game.get_columns()) {
+        const int rows = game.get_rows();
+        m_grid.reserve(m_stride * (rows + 2));
+
+        for (int j = -1; j <= rows; j++)
+            for (int i = -1; i < m_stride - 1; i++)
+                m_grid.push_back(game.get_grid_cell(i, j));
+    }
+
+    int reveal_cell(const int x, const int y) {
+        const int index = (y + 1) * m_stride + x + 1;
+
+        m_grid[index].revealed = true;
+        m_unrevealed_count--;
+
+        if (m_grid[index].type == Game::CELL_0) {
+            reveal_cell_border(index);
+            reveal_cells_dfs(index);
+        }
+
+        return m_unrevealed_count;
+    }
+
+    [[nodiscard]] bool is_revealed(const int x, const int y) const {
+        return m_grid[(y + 1) * m_stride + x + 1].revealed;
+    }
+
+private:
+    void reveal_cells_dfs(const int index) { // NOLINT(*-no-recursion)
+        for (const int offset : m_offsets) {
+            const int neighbour = index + offset;
+            GridCell &cell = m_grid[neighbour];
+
+            if (cell.type != Game::CELL_0 || cell.revealed)
+                continue;
+
+            cell.revealed = true;
+            m_unrevealed_count--;
+            reveal_cell_border(neighbour);
+            reveal_cells_dfs(neighbour);
+        }
+    }
+
+    void reveal_cell_border(const int index) {
+        for (const int offset : m_offsets) {
+            GridCell &cell = m_grid[index + offset];
+
+            if (cell.revealed || cell.type == Game::CELL_0 || cell.type == Game::CELL_MINE)
+                continue;
+
+            cell.revealed = true;
+            m_unrevealed_count--;
+        }
+    }
+};
+
+/**
+ * Whether both fills reveal the same cells on every seeded board with mines
+ */
+static bool fills_agree_on_mined_boards() {
+    constexpr int side = MINED_BOARD_SIDE;
+
+    for (const int density : MINED_BOARD_DENSITIES)
+        for (int seed = 0; seed < MINED_BOARD_SEEDS; seed++) {
+            CounterRandom random(CounterRandom::mix(seed));
+            const int x = random.uniform(0, side - 1);
+            const int y = random.uniform(0, side - 1);
+
+            Game game(side, side, side * side * density / 100, seed);
+            game.place_grid_mines(x, y);
+
+            RecursiveFloodFill recursive(game);
+            recursive.reveal_cell(x, y);
+            game.reveal_cell(x, y);
+
+            for (int j = 0; j < side; j++)
+                for (int i = 0; i < side; i++)
+                    if (game.get_grid_cell(i, j).revealed != recursive.is_revealed(i, j))
+                        return false;
+        }
+
+    return true;
+}
+
+static double elapsed_ms(const Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main() {
+    using std::cout;
+    using std::setw;
+
+    if (!fills_agree_on_mined_boards()) {
+        std::cerr << "Iterative and recursive flood fills disagree on a board with mines" << std::endl;
+        return 1;
+    }
+
+    cout << setw(11) << "board" << setw(16) << "iterative (ms)" << setw(16) << "recursive (ms)" << std::endl;
+
+    for (const int side : BOARD_SIDES) {
+        Game game(side, side, 0);
+        game.place_grid_mines(side / 2, side / 2);
+
+        const RecursiveFloodFill recursive_reference(game);
+
+        Clock::time_point start = Clock::now();
+        const size_t revealed = game.reveal_cell(side / 2, side / 2).size();
+        const double iterative_ms = elapsed_ms(start);
+
+        cout << setw(5) << side << " x " << std::left << setw(5) << side << std::right
+                << setw(16) << std::fixed << std::setprecision(2) << iterative_ms;
+
+        if (side * side > RECURSIVE_MAX_CELLS) {
+            cout << setw(16) << "stack overflow" << std::endl;
+            continue;
+        }
+
+        RecursiveFloodFill recursive = recursive_reference;
+
+        start = Clock::now();
+        const int unrevealed = recursive.reveal_cell(side / 2, side / 2);
+        const double recursive_ms = elapsed_ms(start);
+
+        cout << setw(16) << recursive_ms << std::endl;
+
+        if (unrevealed != side * side - static_cast<int>(revealed)) {
+            std::cerr << "Iterative and recursive flood fills disagree" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "SDL2_imageFilter.h"
+
+/**
+ * Compares the C, SSE2 and AVX2 routines of the SDL2_imageFilter byte filters on a full HD ARGB buffer.
+ * The length isn't a multiple of the vector widths, so the C routine still finishes every filter, and every result
+ * is checked against the C routine's.
+ */
+
+using Clock = std::chrono::steady_clock;
+using Bytes = std::vector<unsigned char>;
+using Filter = int (*)(unsigned char *src1, unsigned char *src2, unsigned char *dest, unsigned int length);
+
+static constexpr unsigned BUFFER_LENGTH = 1920 * 1080 * 4 + 13;
+static constexpr int RUNS = 20;
+
+static constexpr struct {
+    const char *name;
+    Filter filter;
+} FILTERS[] = {
+    {"Add", SDL_imageFilterAdd},
+    {"Mean", SDL_imageFilterMean},
+    {"Sub", SDL_imageFilterSub},
+    {"AbsDiff", SDL_imageFilterAbsDiff},
+    {"Mult", SDL_imageFilterMult},
+    {"MultNor", SDL_imageFilterMultNor},
+    {"MultDivby2", SDL_imageFilterMultDivby2},
+    {"MultDivby4", SDL_imageFilterMultDivby4},
+    {"BitAnd", SDL_imageFilterBitAnd},
+    {"BitOr", SDL_imageFilterBitOr},
+    {"BitNegation", [](unsigned char *src1, unsigned char *, unsigned char *dest, const unsigned int length) {
+        return SDL_imageFilterBitNegation(src1, dest, length);
+    }},
+    {"AddByte", [](unsigned char *src1, unsigned char *, unsigned char *dest, const unsigned int length) {
+        return SDL_imageFilterAddByte(src1, dest, length, 77);
+    }},
+    {"SubByte", [](unsigned char *src1, unsigned char *, unsigned char *dest, const unsigned int length) {
+        return SDL_imageFilterSubByte(src1, dest, length, 77);
+    }},
+    {"ShiftRight", [](unsigned char *src1, unsigned char *, unsigned char *dest, const unsigned int length) {
+        return SDL_imageFilterShiftRight(src1, dest, length, 3);
+    }},
+    {"MultByByte", [](unsigned char *src1, unsigned char *, unsigned char *dest, const unsigned int length) {
+        return SDL_imageFilterMultByByte(src1, dest, length, 3);
+    }},
+    {"ShiftLeftByte", [](unsigned char *src1, unsigned char *, unsigned char *dest, const unsigned int length) {
+        return SDL_imageFilterShiftLeftByte(src1, dest, length, 3);
+    }},
+    {"Binarize", [](unsigned char *src1, unsigned char *, unsigned char *dest, const unsigned int length) {
+        return SDL_imageFilterBinarizeUsingThreshold(src1, dest, length, 128);
+    }},
+    {"ClipToRange", [](unsigned char *src1, unsigned char *, unsigned char *dest, const unsigned int length) {
+        return SDL_imageFilterClipToRange(src1, dest, length, 40, 200);
+    }},
+};
+
+static constexpr struct {
+    const char *name;
+    int level;
+} SIMD_LEVELS[] = {
+    {"SSE2", SDL_IMAGEFILTER_SIMD_SSE2},
+    {"AVX2", SDL_IMAGEFILTER_SIMD_AVX2},
+};
+
+/**
+ * Best of RUNS, the first one also warms up the destination
+ */
+static double time_filter_ms(const Filter filter, Bytes &src1, Bytes &src2, Bytes &dest) {
+    double best_ms = 0;
+
+    for (int i = 0; i < RUNS; i++) {
+        const Clock::time_point start = Clock::now();
+        filter(src1.data(), src2.data(), dest.data(), BUFFER_LENGTH);
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        best_ms = i == 0 ? ms : std::min(best_ms, ms);
+    }
+
+    return best_ms;
+}
+
+int main() {
+    using std::cout;
+    using std::setw;
+
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+    Bytes src1(BUFFER_LENGTH), src2(BUFFER_LENGTH), expected(BUFFER_LENGTH), dest(BUFFER_LENGTH);
+
+    for (unsigned i = 0; i < BUFFER_LENGTH; i++) {
+        src1[i] = byte(random);
+        src2[i] = byte(random);
+    }
+
+    cout << setw(14) << "filter" << setw(10) << "C (ms)";
+    for (const auto &[name, level] : SIMD_LEVELS)
+        cout << setw(7) << name << " (ms)" << setw(9) << "speedup";
+    cout << std::endl;
+
+    bool mismatch = false;
+
+    for (const auto &[name, filter] : FILTERS) {
+        SDL_imageFilterMMXoff();
+        const double scalar_ms = time_filter_ms(filter, src1, src2, expected);
+        SDL_imageFilterMMXon();
+
+        cout << setw(14) << name << setw(10) << std::fixed << std::setprecision(2) << scalar_ms;
+
+        for (const auto &[level_name, level] : SIMD_LEVELS) {
+            SDL_imageFilterSetMaxSIMD(level);
+
+            if (SDL_imageFilterSIMDdetect() != level) {
+                cout << setw(12) << "n/a" << setw(9) << "";
+                continue;
+            }
+
+            std::fill(dest.begin(), dest.end(), 0);
+            const double ms = time_filter_ms(filter, src1, src2, dest);
+
+            cout << setw(12) << ms << setw(8) << scalar_ms / ms << 'x';
+
+            if (dest != expected) {
+                std::cerr << std::endl << name << ": " << level_name << " and C routines disagree" << std::endl;
+                mismatch = true;
+            }
+        }
+
+        cout << std::endl;
+    }
+
+    SDL_imageFilterSetMaxSIMD(SDL_IMAGEFILTER_SIMD_AVX2);
+
+    return mismatch ? 1 : 0;
+}
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "core/game.hpp"
+#include "core/solver.hpp"
+
+/**
+ * Times Solver::update after every reveal of games played by the solver itself, guessing the first unknown cell
+ * whenever it's stuck. Reports the time per move, which has to stay well under a millisecond.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+struct Board {
+    const char *name;
+    int rows;
+    int columns;
+    int mines;
+    int games;
+};
+
+static constexpr Board BOARDS[] = {
+    {"Huge", 27, 48, 220, 2000},
+    {"256 x 256", 256, 256, 10000, 20},
+    {"1024 x 1024", 1024, 1024, 160000, 2},
+};
+
+static void play(const Board &board, const uint64_t seed, std::vector<double> &move_times) {
+    Game game(board.rows, board.columns, board.mines, seed);
+    Solver solver(game);
+
+    game.place_grid_mines(board.columns / 2, board.rows / 2);
+    int x = board.columns / 2, y = board.rows / 2;
+
+    while (true) {
+        const std::vector<Game::GridCoords> &revealed = game.reveal_cell(x, y);
+
+        const Clock::time_point start = Clock::now();
+        solver.update(revealed);
+        move_times.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+
+        if (game.is_over())
+            return;
+
+        if (!solver.get_safe_cells().empty()) {
+            const Game::GridCoords next = solver.get_coords(solver.get_safe_cells().back());
+            x = next.x;
+            y = next.y;
+            continue;
+        }
+
+        // Guess, scanning from where the last guess was
+        while (solver.get_state(x, y) != Solver::STATE_UNKNOWN) {
+            x = (x + 1) % board.columns;
+            y = x == 0 ? (y + 1) % board.rows : y;
+        }
+    }
+}
+
+int main() {
+    using std::cout;
+    using std::setw;
+
+    cout << std::left << setw(14) << "board" << std::right << setw(10) << "moves" << setw(12) << "mean (us)"
+            << setw(12) << "p99 (us)" << setw(12) << "p99.9 (us)" << std::endl;
+
+    for (const Board &board : BOARDS) {
+        std::vector<double> move_times;
+
+        for (int i = 0; i < board.games; i++)
+            play(board, i, move_times);
+
+        std::sort(move_times.begin(), move_times.end());
+
+        double total = 0;
+        for (const double time : move_times)
+            total += time;
+
+        const size_t moves = move_times.size();
+
+        cout << std::left << setw(14) << board.name << std::right << setw(10) << moves
+                << std::fixed << std::setprecision(2)
+                << setw(12) << total / moves
+                << setw(12) << move_times[moves * 99 / 100]
+                << setw(12) << move_times[moves * 999 / 1000] << std::endl;
+    }
+
+    return 0;
+}
@@ -56,6 +56,17 @@ him for his work.
 #  include <SDL_cpuinfo.h>
 #endif
 
+/* SSE2 and AVX2 intrinsics, each routine is compiled for its own instruction set and picked at runtime. */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define SDL_IMAGEFILTER_TARGET(isa) __attribute__((target(isa)))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  define SDL_IMAGEFILTER_TARGET(isa)
+#endif
+#ifdef SDL_IMAGEFILTER_TARGET
+#  include <immintrin.h>
+#  define SDL_IMAGEFILTER_X86
+#endif
+
 #include "SDL2_imageFilter.h"
 
 /*!
@@ -86,7 +97,12 @@ int SDL_imageFilterMMXdetect(void) {
         return 0;
     }
 
+#ifdef USE_MMX
     return SDL_HasMMX();
+#else
+    /* The MMX routines are empty without USE_MMX, so only the C routines can run */
+    return 0;
+#endif
 }
 
 /*!
@@ -103,6 +119,229 @@ void SDL_imageFilterMMXon() {
     SDL_imageFilterUseMMX = 1;
 }
 
+/*!
+\brief Static state which caps the instruction set of the SSE2 and AVX2 routines. Uncapped by default
+*/
+static int SDL_imageFilterMaxSIMD = SDL_IMAGEFILTER_SIMD_AVX2;
+
+/*!
+\brief SSE2 and AVX2 detection routine (with the MMX override flag and the cap set by SDL_imageFilterSetMaxSIMD()).
+
+\returns SDL_IMAGEFILTER_SIMD_AVX2 or SDL_IMAGEFILTER_SIMD_SSE2 for the routines the filter functions use,
+SDL_IMAGEFILTER_SIMD_NONE if they use the MMX or C routines.
+*/
+int SDL_imageFilterSIMDdetect(void) {
+#ifdef SDL_IMAGEFILTER_X86
+    /* Check override flag */
+    if (SDL_imageFilterUseMMX == 0) {
+        return SDL_IMAGEFILTER_SIMD_NONE;
+    }
+
+    /* SDL caches the CPUID results */
+    if (SDL_imageFilterMaxSIMD >= SDL_IMAGEFILTER_SIMD_AVX2 && SDL_HasAVX2()) {
+        return SDL_IMAGEFILTER_SIMD_AVX2;
+    }
+    if (SDL_imageFilterMaxSIMD >= SDL_IMAGEFILTER_SIMD_SSE2 && SDL_HasSSE2()) {
+        return SDL_IMAGEFILTER_SIMD_SSE2;
+    }
+#endif
+
+    return SDL_IMAGEFILTER_SIMD_NONE;
+}
+
+/*!
+\brief Cap the instruction set used by filter functions, e.g. to compare them. Instruction sets the CPU lacks are never used.
+
+\param level SDL_IMAGEFILTER_SIMD_NONE, SDL_IMAGEFILTER_SIMD_SSE2 or SDL_IMAGEFILTER_SIMD_AVX2.
+*/
+void SDL_imageFilterSetMaxSIMD(const int level) {
+    SDL_imageFilterMaxSIMD = level;
+}
+
+/* ------ SSE2 and AVX2 routines ----- */
+
+/*
+Each filter with SSE2 and AVX2 routines gets a <filter>SIMD(...) function that runs the best one over the whole
+vectors of the arrays, unaligned, and returns how many bytes it processed so the C routine does the rest. Results
+match the C routines bit for bit. Binary filters combine the vectors a and b, unary ones transform a with the byte
+constants P and Q.
+*/
+#ifdef SDL_IMAGEFILTER_X86
+
+#define SDL_IMAGEFILTER_BINARY_KERNEL(name, isa, vector, width, load, store, op)                                     \
+static SDL_IMAGEFILTER_TARGET(isa) unsigned int name(                                                                \
+    const unsigned char *Src1,                                                                                       \
+    const unsigned char *Src2,                                                                                       \
+    unsigned char *Dest,                                                                                             \
+    const unsigned int length                                                                                        \
+) {                                                                                                                  \
+    unsigned int i;                                                                                                  \
+    for (i = 0; i + (width) <= length; i += (width)) {                                                               \
+        const vector a = load((const vector *)(Src1 + i));                                                           \
+        const vector b = load((const vector *)(Src2 + i));                                                           \
+        store((vector *)(Dest + i), op);                                                                             \
+    }                                                                                                                \
+    return i;                                                                                                        \
+}
+
+#define SDL_IMAGEFILTER_UNARY_KERNEL(name, isa, vector, width, load, store, op)                                      \
+static SDL_IMAGEFILTER_TARGET(isa) unsigned int name(                                                                \
+    const unsigned char *Src1,                                                                                       \
+    unsigned char *Dest,                                                                                             \
+    const unsigned int length,                                                                                       \
+    const unsigned char P,                                                                                           \
+    const unsigned char Q                                                                                            \
+) {                                                                                                                  \
+    unsigned int i;                                                                                                  \
+    (void)P;                                                                                                         \
+    (void)Q;                                                                                                         \
+    for (i = 0; i + (width) <= length; i += (width)) {                                                               \
+        const vector a = load((const vector *)(Src1 + i));                                                           \
+        store((vector *)(Dest + i), op);                                                                             \
+    }                                                                                                                \
+    return i;                                                                                                        \
+}
+
+#define SDL_IMAGEFILTER_BINARY_SIMD(filter, sse2_op, avx2_op)                                                        \
+SDL_IMAGEFILTER_BINARY_KERNEL(filter##SSE2, "sse2", __m128i, 16, _mm_loadu_si128, _mm_storeu_si128, sse2_op)        \
+SDL_IMAGEFILTER_BINARY_KERNEL(filter##AVX2, "avx2", __m256i, 32, _mm256_loadu_si256, _mm256_storeu_si256, avx2_op)  \
+static unsigned int filter##SIMD(                                                                                    \
+    const unsigned char *Src1,                                                                                       \
+    const unsigned char *Src2,                                                                                       \
+    unsigned char *Dest,                                                                                             \
+    const unsigned int length                                                                                        \
+) {                                                                                                                  \
+    switch (SDL_imageFilterSIMDdetect()) {                                                                           \
+        case SDL_IMAGEFILTER_SIMD_AVX2:                                                                              \
+            return filter##AVX2(Src1, Src2, Dest, length);                                                           \
+        case SDL_IMAGEFILTER_SIMD_SSE2:                                                                              \
+            return filter##SSE2(Src1, Src2, Dest, length);                                                           \
+        default:                                                                                                     \
+            return 0;                                                                                                \
+    }                                                                                                                \
+}
+
+#define SDL_IMAGEFILTER_UNARY_SIMD(filter, sse2_op, avx2_op)                                                         \
+SDL_IMAGEFILTER_UNARY_KERNEL(filter##SSE2, "sse2", __m128i, 16, _mm_loadu_si128, _mm_storeu_si128, sse2_op)         \
+SDL_IMAGEFILTER_UNARY_KERNEL(filter##AVX2, "avx2", __m256i, 32, _mm256_loadu_si256, _mm256_storeu_si256, avx2_op)   \
+static unsigned int filter##SIMD(                                                                                    \
+    const unsigned char *Src1,                                                                                       \
+    unsigned char *Dest,                                                                                             \
+    const unsigned int length,                                                                                       \
+    const unsigned char P,                                                                                           \
+    const unsigned char Q                                                                                            \
+) {                                                                                                                  \
+    switch (SDL_imageFilterSIMDdetect()) {                                                                           \
+        case SDL_IMAGEFILTER_SIMD_AVX2:                                                                              \
+            return filter##AVX2(Src1, Dest, length, P, Q);                                                           \
+        case SDL_IMAGEFILTER_SIMD_SSE2:                                                                              \
+            return filter##SSE2(Src1, Dest, length, P, Q);                                                           \
+        default:                                                                                                     \
+            return 0;                                                                                                \
+    }                                                                                                                \
+}
+
+/*!
+\brief Multiplies unsigned bytes through 16 bit words: D = saturation255(S1 * S2), or the low byte of S1 * S2.
+*/
+static inline SDL_IMAGEFILTER_TARGET("sse2") __m128i SDL_imageFilterMulBytesSSE2(
+    const __m128i a,
+    const __m128i b,
+    const int saturate
+) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i low = _mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+    __m128i high = _mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+
+    if (saturate) {
+        /* Products over 255 saturate the add, so the sub leaves 255 */
+        const __m128i bias = _mm_set1_epi16((short)0xff00);
+        low = _mm_subs_epu16(_mm_adds_epu16(low, bias), bias);
+        high = _mm_subs_epu16(_mm_adds_epu16(high, bias), bias);
+    } else {
+        const __m128i mask = _mm_set1_epi16(0x00ff);
+        low = _mm_and_si128(low, mask);
+        high = _mm_and_si128(high, mask);
+    }
+
+    return _mm_packus_epi16(low, high);
+}
+
+/*!
+\brief AVX2 version of SDL_imageFilterMulBytesSSE2(). Unpacking and packing both work within 128 bit lanes, so bytes
+stay in place.
+*/
+static inline SDL_IMAGEFILTER_TARGET("avx2") __m256i SDL_imageFilterMulBytesAVX2(
+    const __m256i a,
+    const __m256i b,
+    const int saturate
+) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i low = _mm256_mullo_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+    __m256i high = _mm256_mullo_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+
+    if (saturate) {
+        const __m256i bias = _mm256_set1_epi16((short)0xff00);
+        low = _mm256_subs_epu16(_mm256_adds_epu16(low, bias), bias);
+        high = _mm256_subs_epu16(_mm256_adds_epu16(high, bias), bias);
+    } else {
+        const __m256i mask = _mm256_set1_epi16(0x00ff);
+        low = _mm256_and_si256(low, mask);
+        high = _mm256_and_si256(high, mask);
+    }
+
+    return _mm256_packus_epi16(low, high);
+}
+
+/*!
+\brief Halves unsigned bytes, there's no byte shift so it shifts words and masks off the bits from the next byte.
+*/
+#define SDL_IMAGEFILTER_HALF_SSE2(a) _mm_and_si128(_mm_srli_epi16(a, 1), _mm_set1_epi8(0x7f))
+#define SDL_IMAGEFILTER_HALF_AVX2(a) _mm256_and_si256(_mm256_srli_epi16(a, 1), _mm256_set1_epi8(0x7f))
+
+/*!
+\brief Unsigned byte compare: all ones where a >= b.
+*/
+#define SDL_IMAGEFILTER_GE_SSE2(a, b) _mm_cmpeq_epi8(_mm_max_epu8(a, b), a)
+#define SDL_IMAGEFILTER_GE_AVX2(a, b) _mm256_cmpeq_epi8(_mm256_max_epu8(a, b), a)
+
+/*!
+\brief Clamps unsigned bytes to [min, max], checking min first like the C routine of ClipToRange does.
+*/
+#define SDL_IMAGEFILTER_CLIP_SSE2(a, min, max) _mm_or_si128(                                                          \
+    _mm_and_si128(SDL_IMAGEFILTER_GE_SSE2(a, min), _mm_min_epu8(a, max)),                                            \
+    _mm_andnot_si128(SDL_IMAGEFILTER_GE_SSE2(a, min), min)                                                           \
+)
+#define SDL_IMAGEFILTER_CLIP_AVX2(a, min, max) _mm256_or_si256(                                                       \
+    _mm256_and_si256(SDL_IMAGEFILTER_GE_AVX2(a, min), _mm256_min_epu8(a, max)),                                      \
+    _mm256_andnot_si256(SDL_IMAGEFILTER_GE_AVX2(a, min), min)                                                        \
+)
+
+#else
+
+#define SDL_IMAGEFILTER_BINARY_SIMD(filter, sse2_op, avx2_op)                                                        \
+static unsigned int filter##SIMD(                                                                                    \
+    const unsigned char *Src1,                                                                                       \
+    const unsigned char *Src2,                                                                                       \
+    unsigned char *Dest,                                                                                             \
+    const unsigned int length                                                                                        \
+) {                                                                                                                  \
+    return 0;                                                                                                        \
+}
+
+#define SDL_IMAGEFILTER_UNARY_SIMD(filter, sse2_op, avx2_op)                                                         \
+static unsigned int filter##SIMD(                                                                                    \
+    const unsigned char *Src1,                                                                                       \
+    unsigned char *Dest,                                                                                             \
+    const unsigned int length,                                                                                       \
+    const unsigned char P,                                                                                           \
+    const unsigned char Q                                                                                            \
+) {                                                                                                                  \
+    return 0;                                                                                                        \
+}
+
+#endif
+
 /* ------------------------------------------------------------------------------------ */
 
 /*!
@@ -164,6 +403,8 @@ L1010:
 #endif
 }
 
+SDL_IMAGEFILTER_BINARY_SIMD(SDL_imageFilterAdd, _mm_adds_epu8(a, b), _mm256_adds_epu8(a, b))
+
 /*!
 \brief Filter using Add: D = saturation255(S1 + S2)
 
@@ -184,7 +425,13 @@ int SDL_imageFilterAdd(unsigned char *Src1, unsigned char *Src2, unsigned char *
     if (length == 0)
         return 0;
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterAddSIMD(Src1, Src2, Dest, length);
+        cursrc1 = &Src1[istart];
+        cursrc2 = &Src2[istart];
+        curdst = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         /* Use MMX assembly routine */
         SDL_imageFilterAddMMX(Src1, Src2, Dest, length);
 
@@ -300,6 +547,12 @@ L21011:
 #endif
 }
 
+SDL_IMAGEFILTER_BINARY_SIMD(
+    SDL_imageFilterMean,
+    _mm_add_epi8(SDL_IMAGEFILTER_HALF_SSE2(a), SDL_IMAGEFILTER_HALF_SSE2(b)),
+    _mm256_add_epi8(SDL_IMAGEFILTER_HALF_AVX2(a), SDL_IMAGEFILTER_HALF_AVX2(b))
+)
+
 /*!
 \brief Filter using Mean: D = S1/2 + S2/2
 
@@ -321,7 +574,13 @@ int SDL_imageFilterMean(unsigned char *Src1, unsigned char *Src2, unsigned char
     if (length == 0)
         return 0;
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterMeanSIMD(Src1, Src2, Dest, length);
+        cursrc1 = &Src1[istart];
+        cursrc2 = &Src2[istart];
+        curdst = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         /* MMX routine */
         SDL_imageFilterMeanMMX(Src1, Src2, Dest, length, Mask);
 
@@ -416,6 +675,8 @@ L1012:
 #endif
 }
 
+SDL_IMAGEFILTER_BINARY_SIMD(SDL_imageFilterSub, _mm_subs_epu8(a, b), _mm256_subs_epu8(a, b))
+
 /*!
 \brief Filter using Sub: D = saturation0(S1 - S2)
 
@@ -436,7 +697,13 @@ int SDL_imageFilterSub(unsigned char *Src1, unsigned char *Src2, unsigned char *
     if (length == 0)
         return 0;
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterSubSIMD(Src1, Src2, Dest, length);
+        cursrc1 = &Src1[istart];
+        cursrc2 = &Src2[istart];
+        curdst = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         /* MMX routine */
         SDL_imageFilterSubMMX(Src1, Src2, Dest, length);
 
@@ -538,6 +805,12 @@ L1013:
 #endif
 }
 
+SDL_IMAGEFILTER_BINARY_SIMD(
+    SDL_imageFilterAbsDiff,
+    _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a)),
+    _mm256_or_si256(_mm256_subs_epu8(a, b), _mm256_subs_epu8(b, a))
+)
+
 /*!
 \brief Filter using AbsDiff: D = | S1 - S2 |
 
@@ -558,7 +831,13 @@ int SDL_imageFilterAbsDiff(unsigned char *Src1, unsigned char *Src2, unsigned ch
     if (length == 0)
         return 0;
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterAbsDiffSIMD(Src1, Src2, Dest, length);
+        cursrc1 = &Src1[istart];
+        cursrc2 = &Src2[istart];
+        curdst = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         /* MMX routine */
         SDL_imageFilterAbsDiffMMX(Src1, Src2, Dest, length);
 
@@ -727,6 +1006,12 @@ L1014:
 #endif
 }
 
+SDL_IMAGEFILTER_BINARY_SIMD(
+    SDL_imageFilterMult,
+    SDL_imageFilterMulBytesSSE2(a, b, 1),
+    SDL_imageFilterMulBytesAVX2(a, b, 1)
+)
+
 /*!
 \brief Filter using Mult: D = saturation255(S1 * S2)
 
@@ -747,7 +1032,13 @@ int SDL_imageFilterMult(unsigned char *Src1, unsigned char *Src2, unsigned char
     if (length == 0)
         return 0;
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterMultSIMD(Src1, Src2, Dest, length);
+        cursrc1 = &Src1[istart];
+        cursrc2 = &Src2[istart];
+        curdst = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         /* MMX routine */
         SDL_imageFilterMultMMX(Src1, Src2, Dest, length);
 
@@ -856,6 +1147,12 @@ L10141:
 #endif
 }
 
+SDL_IMAGEFILTER_BINARY_SIMD(
+    SDL_imageFilterMultNor,
+    SDL_imageFilterMulBytesSSE2(a, b, 0),
+    SDL_imageFilterMulBytesAVX2(a, b, 0)
+)
+
 /*!
 \brief Filter using MultNor: D = S1 * S2
 
@@ -876,7 +1173,13 @@ int SDL_imageFilterMultNor(unsigned char *Src1, unsigned char *Src2, unsigned ch
     if (length == 0)
         return 0;
 
-    if (SDL_imageFilterMMXdetect()) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterMultNorSIMD(Src1, Src2, Dest, length);
+        cursrc1 = &Src1[istart];
+        cursrc2 = &Src2[istart];
+        curdst = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect()) {
         if (length > 0) {
             /* ASM routine */
             SDL_imageFilterMultNorASM(Src1, Src2, Dest, length);
@@ -997,6 +1300,12 @@ L1015:
 #endif
 }
 
+SDL_IMAGEFILTER_BINARY_SIMD(
+    SDL_imageFilterMultDivby2,
+    SDL_imageFilterMulBytesSSE2(SDL_IMAGEFILTER_HALF_SSE2(a), b, 1),
+    SDL_imageFilterMulBytesAVX2(SDL_IMAGEFILTER_HALF_AVX2(a), b, 1)
+)
+
 /*!
 \brief Filter using MultDivby2: D = saturation255(S1/2 * S2)
 
@@ -1022,7 +1331,13 @@ int SDL_imageFilterMultDivby2(
     if (length == 0)
         return 0;
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterMultDivby2SIMD(Src1, Src2, Dest, length);
+        cursrc1 = &Src1[istart];
+        cursrc2 = &Src2[istart];
+        curdst = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         /* MMX routine */
         SDL_imageFilterMultDivby2MMX(Src1, Src2, Dest, length);
 
@@ -1145,6 +1460,12 @@ L1016:
 #endif
 }
 
+SDL_IMAGEFILTER_BINARY_SIMD(
+    SDL_imageFilterMultDivby4,
+    SDL_imageFilterMulBytesSSE2(SDL_IMAGEFILTER_HALF_SSE2(a), SDL_IMAGEFILTER_HALF_SSE2(b), 1),
+    SDL_imageFilterMulBytesAVX2(SDL_IMAGEFILTER_HALF_AVX2(a), SDL_IMAGEFILTER_HALF_AVX2(b), 1)
+)
+
 /*!
 \brief Filter using MultDivby4: D = saturation255(S1/2 * S2/2)
 
@@ -1170,7 +1491,13 @@ int SDL_imageFilterMultDivby4(
     if (length == 0)
         return 0;
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterMultDivby4SIMD(Src1, Src2, Dest, length);
+        cursrc1 = &Src1[istart];
+        cursrc2 = &Src2[istart];
+        curdst = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         /* MMX routine */
         SDL_imageFilterMultDivby4MMX(Src1, Src2, Dest, length);
 
@@ -1289,6 +1616,8 @@ L1017:
 #endif
 }
 
+SDL_IMAGEFILTER_BINARY_SIMD(SDL_imageFilterBitAnd, _mm_and_si128(a, b), _mm256_and_si256(a, b))
+
 /*!
 \brief Filter using BitAnd: D = S1 & S2
 
@@ -1309,7 +1638,13 @@ int SDL_imageFilterBitAnd(unsigned char *Src1, unsigned char *Src2, unsigned cha
     if (length == 0)
         return 0;
 
-    if (SDL_imageFilterMMXdetect() > 0 && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterBitAndSIMD(Src1, Src2, Dest, length);
+        cursrc1 = &Src1[istart];
+        cursrc2 = &Src2[istart];
+        curdst = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() > 0 && length > 7) {
         /*  if (length > 7) { */
         /* Call MMX routine */
 
@@ -1405,6 +1740,8 @@ L91017:
 #endif
 }
 
+SDL_IMAGEFILTER_BINARY_SIMD(SDL_imageFilterBitOr, _mm_or_si128(a, b), _mm256_or_si256(a, b))
+
 /*!
 \brief Filter using BitOr: D = S1 | S2
 
@@ -1425,7 +1762,13 @@ int SDL_imageFilterBitOr(unsigned char *Src1, unsigned char *Src2, unsigned char
     if (length == 0)
         return 0;
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterBitOrSIMD(Src1, Src2, Dest, length);
+        cursrc1 = &Src1[istart];
+        cursrc2 = &Src2[istart];
+        curdst = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         /* MMX routine */
         SDL_imageFilterBitOrMMX(Src1, Src2, Dest, length);
 
@@ -1681,6 +2024,12 @@ L91117:
 #endif
 }
 
+SDL_IMAGEFILTER_UNARY_SIMD(
+    SDL_imageFilterBitNegation,
+    _mm_xor_si128(a, _mm_set1_epi8(-1)),
+    _mm256_xor_si256(a, _mm256_set1_epi8(-1))
+)
+
 /*!
 \brief Filter using BitNegation: D = !S
 
@@ -1700,7 +2049,12 @@ int SDL_imageFilterBitNegation(unsigned char *Src1, unsigned char *Dest, const u
     if (length == 0)
         return 0;
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterBitNegationSIMD(Src1, Dest, length, 0, 0);
+        cursrc1 = &Src1[istart];
+        curdst = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         /* MMX routine */
         SDL_imageFilterBitNegationMMX(Src1, Dest, length);
 
@@ -1802,6 +2156,12 @@ L1021:
 #endif
 }
 
+SDL_IMAGEFILTER_UNARY_SIMD(
+    SDL_imageFilterAddByte,
+    _mm_adds_epu8(a, _mm_set1_epi8((char)P)),
+    _mm256_adds_epu8(a, _mm256_set1_epi8((char)P))
+)
+
 /*!
 \brief Filter using AddByte: D = saturation255(S + C)
 
@@ -1829,7 +2189,12 @@ int SDL_imageFilterAddByte(unsigned char *Src1, unsigned char *Dest, const unsig
         return 0;
     }
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterAddByteSIMD(Src1, Dest, length, C, 0);
+        cursrc1 = &Src1[istart];
+        curdest = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         /* MMX routine */
         SDL_imageFilterAddByteMMX(Src1, Dest, length, C);
 
@@ -2211,6 +2576,12 @@ L1023:
 #endif
 }
 
+SDL_IMAGEFILTER_UNARY_SIMD(
+    SDL_imageFilterSubByte,
+    _mm_subs_epu8(a, _mm_set1_epi8((char)P)),
+    _mm256_subs_epu8(a, _mm256_set1_epi8((char)P))
+)
+
 /*!
 \brief Filter using SubByte: D = saturation0(S - C)
 
@@ -2238,7 +2609,12 @@ int SDL_imageFilterSubByte(unsigned char *Src1, unsigned char *Dest, const unsig
         return 0;
     }
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterSubByteSIMD(Src1, Dest, length, C, 0);
+        cursrc1 = &Src1[istart];
+        curdest = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         /* MMX routine */
         SDL_imageFilterSubByteMMX(Src1, Dest, length, C);
 
@@ -2494,6 +2870,12 @@ L10241:
 #endif
 }
 
+SDL_IMAGEFILTER_UNARY_SIMD(
+    SDL_imageFilterShiftRight,
+    _mm_and_si128(_mm_srl_epi16(a, _mm_cvtsi32_si128(P)), _mm_set1_epi8((char)(0xff >> P))),
+    _mm256_and_si256(_mm256_srl_epi16(a, _mm_cvtsi32_si128(P)), _mm256_set1_epi8((char)(0xff >> P)))
+)
+
 /*!
 \brief Filter using ShiftRight: D = saturation0(S >> N)
 
@@ -2532,7 +2914,12 @@ int SDL_imageFilterShiftRight(
         return 0;
     }
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterShiftRightSIMD(Src1, Dest, length, N, 0);
+        cursrc1 = &Src1[istart];
+        curdest = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         /* MMX routine */
         SDL_imageFilterShiftRightMMX(Src1, Dest, length, N, Mask);
 
@@ -2820,6 +3207,12 @@ L10252:
 #endif
 }
 
+SDL_IMAGEFILTER_UNARY_SIMD(
+    SDL_imageFilterMultByByte,
+    SDL_imageFilterMulBytesSSE2(a, _mm_set1_epi8((char)P), 1),
+    SDL_imageFilterMulBytesAVX2(a, _mm256_set1_epi8((char)P), 1)
+)
+
 /*!
 \brief Filter using MultByByte: D = saturation255(S * C)
 
@@ -2852,7 +3245,12 @@ int SDL_imageFilterMultByByte(
         return 0;
     }
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterMultByByteSIMD(Src1, Dest, length, C, 0);
+        cursrc1 = &Src1[istart];
+        curdest = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         SDL_imageFilterMultByByteMMX(Src1, Dest, length, C);
 
         /* Check for unaligned bytes */
@@ -3133,6 +3531,12 @@ L10271:
 #endif
 }
 
+SDL_IMAGEFILTER_UNARY_SIMD(
+    SDL_imageFilterShiftLeftByte,
+    _mm_and_si128(_mm_sll_epi16(a, _mm_cvtsi32_si128(P)), _mm_set1_epi8((char)(0xff << P))),
+    _mm256_and_si256(_mm256_sll_epi16(a, _mm_cvtsi32_si128(P)), _mm256_set1_epi8((char)(0xff << P)))
+)
+
 /*!
 \brief Filter using ShiftLeftByte: D = (S << N)
 
@@ -3169,7 +3573,12 @@ int SDL_imageFilterShiftLeftByte(
         return 0;
     }
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterShiftLeftByteSIMD(Src1, Dest, length, N, 0);
+        cursrc1 = &Src1[istart];
+        curdest = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         SDL_imageFilterShiftLeftByteMMX(Src1, Dest, length, N, Mask);
 
         /* Check for unaligned bytes */
@@ -3591,6 +4000,12 @@ L1029:
 #endif
 }
 
+SDL_IMAGEFILTER_UNARY_SIMD(
+    SDL_imageFilterBinarizeUsingThreshold,
+    SDL_IMAGEFILTER_GE_SSE2(a, _mm_set1_epi8((char)P)),
+    SDL_IMAGEFILTER_GE_AVX2(a, _mm256_set1_epi8((char)P))
+)
+
 /*!
 \brief Filter using BinarizeUsingThreshold: D = (S >= T) ? 255:0
 
@@ -3623,7 +4038,12 @@ int SDL_imageFilterBinarizeUsingThreshold(
         return 0;
     }
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterBinarizeUsingThresholdSIMD(Src1, Dest, length, T, 0);
+        cursrc1 = &Src1[istart];
+        curdest = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         SDL_imageFilterBinarizeUsingThresholdMMX(Src1, Dest, length, T);
 
         /* Check for unaligned bytes */
@@ -3754,6 +4174,12 @@ L1030:
 #endif
 }
 
+SDL_IMAGEFILTER_UNARY_SIMD(
+    SDL_imageFilterClipToRange,
+    SDL_IMAGEFILTER_CLIP_SSE2(a, _mm_set1_epi8((char)P), _mm_set1_epi8((char)Q)),
+    SDL_IMAGEFILTER_CLIP_AVX2(a, _mm256_set1_epi8((char)P), _mm256_set1_epi8((char)Q))
+)
+
 /*!
 \brief Filter using ClipToRange: D = (S >= Tmin) & (S <= Tmax) S:Tmin | Tmax
 
@@ -3788,7 +4214,12 @@ int SDL_imageFilterClipToRange(
         return 0;
     }
 
-    if (SDL_imageFilterMMXdetect() && length > 7) {
+    if (SDL_imageFilterSIMDdetect()) {
+        /* SSE2 or AVX2 routine, whole vectors only */
+        istart = SDL_imageFilterClipToRangeSIMD(Src1, Dest, length, Tmin, Tmax);
+        cursrc1 = &Src1[istart];
+        curdest = &Dest[istart];
+    } else if (SDL_imageFilterMMXdetect() && length > 7) {
         SDL_imageFilterClipToRangeMMX(Src1, Dest, length, Tmin, Tmax);
 
         /* Check for unaligned bytes */
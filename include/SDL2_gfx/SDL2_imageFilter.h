@@ -54,6 +54,7 @@ extern "C" {
 /* Comments:                                                                           */
 /*  1.) MMX functions work best if all data blocks are aligned on a 32 bytes boundary. */
 /*  2.) Data that is not within an 8 byte boundary is processed using the C routine.   */
+/*      With SSE2 or AVX2 the boundary is 16 or 32 bytes, alignment doesn't matter.    */
 /*  3.) Convolution routines do not have C routines at this time.                      */
 
 // Detect MMX capability in CPU
@@ -63,6 +64,17 @@ SDL2_IMAGEFILTER_SCOPE int SDL_imageFilterMMXdetect(void);
 SDL2_IMAGEFILTER_SCOPE void SDL_imageFilterMMXoff(void);
 SDL2_IMAGEFILTER_SCOPE void SDL_imageFilterMMXon(void);
 
+// Instruction sets of the SSE2 and AVX2 routines, which the filters prefer over the MMX ones
+#define SDL_IMAGEFILTER_SIMD_NONE 0
+#define SDL_IMAGEFILTER_SIMD_SSE2 1
+#define SDL_IMAGEFILTER_SIMD_AVX2 2
+
+// Detect the instruction set the filters use (turned off along with MMX)
+SDL2_IMAGEFILTER_SCOPE int SDL_imageFilterSIMDdetect(void);
+
+// Cap the instruction set the filters use, e.g. to compare them
+SDL2_IMAGEFILTER_SCOPE void SDL_imageFilterSetMaxSIMD(int level);
+
 //
 // All routines return:
 //   0   OK
@@ -0,0 +1,467 @@
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+#include "game.hpp"
+#include "mine_sampler.hpp"
+#include "random.hpp"
+#include "settings.hpp"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+/**
+ * Game backend storing the board as bitplanes, one bit per cell and plane.
+ * Mines, revealed and flagged cells each take a plane, and the neighbour mine counts are kept as four bit-sliced
+ * planes, for 7 bits per cell instead of the 64 bits of a Game::GridCell.
+ *
+ * Rows are padded to whole 64-bit words and there is an empty padding row above and below the board, so vertical
+ * neighbours never need bounds checks. Bits past the last column are always 0.
+ */
+class BitboardGame {
+public:
+    using CellType = Game::CellType;
+    using GridCell = Game::GridCell;
+    using GridCoords = Game::GridCoords;
+
+private:
+    typedef std::vector<uint64_t> plane_t;
+
+    static constexpr int WORD_BITS = 64;
+    static constexpr int COUNT_PLANES = 4;
+    // Same as Game, so both draw the same random numbers
+    static constexpr int SAFE_ZONE_CROWDED_RATIO = 8;
+
+    const int m_rows;
+    const int m_columns;
+    const int m_total_mines;
+    const int m_words_per_row;
+    uint64_t m_seed;
+    plane_t m_mines;
+    plane_t m_revealed;
+    plane_t m_flagged;
+    plane_t m_counts[COUNT_PLANES];
+    std::vector<GridCoords> m_revealed_cells{};
+    time_t m_start_time = 0;
+    bool m_over = false;
+    bool m_won = false;
+
+public:
+    BitboardGame(
+        const int rows,
+        const int columns,
+        const int total_mines,
+        const uint64_t seed = CounterRandom::make_seed()
+    ) :
+        m_rows(rows),
+        m_columns(columns),
+        m_total_mines(std::min(total_mines, MineSampler::max_mines(rows, columns))),
+        m_words_per_row((columns + WORD_BITS - 1) / WORD_BITS),
+        m_seed(seed),
+        m_mines(make_plane()),
+        m_revealed(make_plane()),
+        m_flagged(make_plane()),
+        m_counts{make_plane(), make_plane(), make_plane(), make_plane()} {}
+
+    ~BitboardGame() = default;
+
+    [[nodiscard]] int get_rows() const {
+        return m_rows;
+    }
+
+    [[nodiscard]] int get_columns() const {
+        return m_columns;
+    }
+
+    [[nodiscard]] uint64_t get_seed() const {
+        return m_seed;
+    }
+
+    [[nodiscard]] int get_remaining_mines() const {
+        return m_total_mines - count(m_flagged);
+    }
+
+    [[nodiscard]] time_t get_start_time() const {
+        return m_start_time;
+    }
+
+    [[nodiscard]] bool has_started() const {
+        return m_start_time != 0;
+    }
+
+    [[nodiscard]] bool is_over() const {
+        return m_over;
+    }
+
+    [[nodiscard]] bool has_won() const {
+        return m_won;
+    }
+
+    /**
+     * Size of all the bitplanes, in bytes
+     */
+    [[nodiscard]] size_t get_memory_usage() const {
+        return m_mines.size() * sizeof(uint64_t) * (3 + COUNT_PLANES);
+    }
+
+    [[nodiscard]] GridCell get_grid_cell(const int x, const int y) const {
+        const int word = word_index(x, y);
+        const uint64_t bit = bit_mask(x);
+
+        GridCell cell;
+        cell.flagged = m_flagged[word] & bit;
+        cell.revealed = m_revealed[word] & bit;
+        cell.type = m_mines[word] & bit ? Game::CELL_MINE : count_at(word, bit);
+
+        return cell;
+    }
+
+    /**
+     * The layout only depends on the seed, the board size and (x, y)
+     */
+    void place_grid_mines(const int x, const int y, const uint64_t seed) {
+        m_seed = seed;
+        place_grid_mines(x, y);
+    }
+
+    void place_grid_mines(const int x, const int y) {
+        m_start_time = time(nullptr);
+
+        CounterRandom random(m_seed);
+
+        // Same layout as a Game with the same seed, see Game::prepare_grid()
+        const std::vector<int> mines = MineSampler::sample(m_rows, m_columns, m_total_mines, random);
+
+        for (const int mine : mines) {
+            const int nx = mine % m_columns;
+            m_mines[word_index(nx, mine / m_columns)] |= bit_mask(nx);
+        }
+
+        // Mines count at (x, y) must be 0
+        clear_safe_zone(x, y);
+        count_surrounding_mines();
+    }
+
+    void toggle_cell_flag(const int x, const int y) {
+        const int word = word_index(x, y);
+        const uint64_t bit = bit_mask(x);
+
+        if (!(m_revealed[word] & bit)) {
+            m_flagged[word] ^= bit;
+            return;
+        }
+
+        const int type = count_at(word, bit);
+
+        if (!Settings::is_on(Settings::EASY_FLAG) || type < Game::CELL_1 || type > Game::CELL_8)
+            return;
+
+        if (count_surrounding(m_revealed, x, y, true) != type)
+            return;
+
+        for_each_neighbour(x, y, [this](const int nx, const int ny) {
+            const int neighbour_word = word_index(nx, ny);
+            const uint64_t neighbour_bit = bit_mask(nx);
+
+            if (!(m_revealed[neighbour_word] & neighbour_bit))
+                m_flagged[neighbour_word] |= neighbour_bit;
+        });
+    }
+
+    /**
+     * Returns the cells revealed by this call, valid until the next one
+     */
+    const std::vector<GridCoords> &reveal_cell(const int x, const int y) {
+        const int word = word_index(x, y);
+        const uint64_t bit = bit_mask(x);
+
+        m_revealed_cells.clear();
+
+        if (m_flagged[word] & bit)
+            return m_revealed_cells;
+
+        if (m_mines[word] & bit) {
+            m_revealed[word] |= bit;
+            m_revealed_cells.push_back({x, y, true});
+            lose();
+            return m_revealed_cells;
+        }
+
+        if (m_revealed[word] & bit) {
+            const int type = count_at(word, bit);
+
+            if (type < Game::CELL_1 || type > Game::CELL_8 || !Settings::is_on(Settings::EASY_DIG))
+                return m_revealed_cells;
+
+            if (count_surrounding_flagged(x, y) != type)
+                return m_revealed_cells;
+
+            bool revealed_mine = false;
+
+            for_each_neighbour(x, y, [&](const int nx, const int ny) {
+                const int neighbour_word = word_index(nx, ny);
+                const uint64_t neighbour_bit = bit_mask(nx);
+
+                if (revealed_mine || (m_revealed[neighbour_word] | m_flagged[neighbour_word]) & neighbour_bit)
+                    return;
+
+                m_revealed[neighbour_word] |= neighbour_bit;
+                m_revealed_cells.push_back({nx, ny, true});
+                revealed_mine = m_mines[neighbour_word] & neighbour_bit;
+            });
+
+            if (revealed_mine) {
+                lose();
+                return m_revealed_cells;
+            }
+        } else {
+            m_revealed[word] |= bit;
+            m_revealed_cells.push_back({x, y, true});
+        }
+
+        reveal_empty_regions();
+
+        if (all_safe_cells_revealed()) {
+            m_over = true;
+            m_won = true;
+        }
+
+        return m_revealed_cells;
+    }
+
+private:
+    [[nodiscard]] plane_t make_plane() const {
+        return plane_t((m_rows + 2) * m_words_per_row, 0);
+    }
+
+    [[nodiscard]] int word_index(const int x, const int y) const {
+        return (y + 1) * m_words_per_row + x / WORD_BITS;
+    }
+
+    static uint64_t bit_mask(const int x) {
+        return uint64_t{1} << x % WORD_BITS;
+    }
+
+    [[nodiscard]] bool is_mine(const int x, const int y) const {
+        return m_mines[word_index(x, y)] & bit_mask(x);
+    }
+
+    [[nodiscard]] CellType count_at(const int word, const uint64_t bit) const {
+        int count = 0;
+
+        for (int i = 0; i < COUNT_PLANES; i++)
+            count |= (m_counts[i][word] & bit ? 1 : 0) << i;
+
+        return static_cast<CellType>(count);
+    }
+
+    static int popcount(const uint64_t word) {
+#if defined(__GNUC__)
+        return __builtin_popcountll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return static_cast<int>(__popcnt64(word));
+#else
+        return static_cast<int>(std::bitset<64>(word).count());
+#endif
+    }
+
+    static int count(const plane_t &plane) {
+        int total = 0;
+
+        for (const uint64_t word : plane)
+            total += popcount(word);
+
+        return total;
+    }
+
+    template <typename Callback>
+    void for_each_neighbour(const int x, const int y, Callback callback) const {
+        for (int j = y - 1; j <= y + 1; j++) {
+            if (j < 0 || j > m_rows - 1)
+                continue;
+
+            for (int i = x - 1; i <= x + 1; i++) {
+                if (i < 0 || i > m_columns - 1 || (i == x && j == y))
+                    continue;
+
+                callback(i, j);
+            }
+        }
+    }
+
+    [[nodiscard]] int count_surrounding(const plane_t &plane, const int x, const int y, const bool inverted) const {
+        int total = 0;
+
+        for_each_neighbour(x, y, [&](const int nx, const int ny) {
+            total += static_cast<bool>(plane[word_index(nx, ny)] & bit_mask(nx)) != inverted;
+        });
+
+        return total;
+    }
+
+    [[nodiscard]] int count_surrounding_flagged(const int x, const int y) const {
+        int total = 0;
+
+        for_each_neighbour(x, y, [&](const int nx, const int ny) {
+            const int word = word_index(nx, ny);
+            total += static_cast<bool>(m_flagged[word] & ~m_revealed[word] & bit_mask(nx));
+        });
+
+        return total;
+    }
+
+    /**
+     * Sum of a row word with its left and right neighbours, as a 2-bit bit-sliced number
+     */
+    void horizontal_sum(const int row_start, const int word, uint64_t *bit0, uint64_t *bit1) const {
+        const uint64_t center = m_mines[row_start + word];
+        const uint64_t previous = word > 0 ? m_mines[row_start + word - 1] : 0;
+        const uint64_t next = word < m_words_per_row - 1 ? m_mines[row_start + word + 1] : 0;
+
+        const uint64_t left = center << 1 | previous >> (WORD_BITS - 1);
+        const uint64_t right = center >> 1 | next << (WORD_BITS - 1);
+
+        *bit0 = left ^ center ^ right;
+        *bit1 = (left & center) | (right & (left ^ center));
+    }
+
+    /**
+     * Word-parallel 3x3 box sum of the mines plane. The center cell is included, which doesn't change the count
+     * of any safe cell.
+     */
+    void count_surrounding_mines() {
+        for (int y = 0; y < m_rows; y++) {
+            const int row_start = (y + 1) * m_words_per_row;
+
+            for (int word = 0; word < m_words_per_row; word++) {
+                uint64_t top0, top1, middle0, middle1, bottom0, bottom1;
+                horizontal_sum(row_start - m_words_per_row, word, &top0, &top1);
+                horizontal_sum(row_start, word, &middle0, &middle1);
+                horizontal_sum(row_start + m_words_per_row, word, &bottom0, &bottom1);
+
+                // Full adder on the weight 1 bits, carry has weight 2
+                const uint64_t sum0 = top0 ^ middle0 ^ bottom0;
+                const uint64_t carry0 = (top0 & middle0) | (bottom0 & (top0 ^ middle0));
+
+                // Weight 2 bits: top1, middle1, bottom1 and carry0
+                const uint64_t partial1 = top1 ^ middle1 ^ bottom1;
+                const uint64_t partial_carry1 = (top1 & middle1) | (bottom1 & (top1 ^ middle1));
+                const uint64_t sum1 = partial1 ^ carry0;
+                const uint64_t carry1 = partial1 & carry0;
+
+                // Weight 4 bits: partial_carry1 and carry1
+                const uint64_t sum2 = partial_carry1 ^ carry1;
+                const uint64_t sum3 = partial_carry1 & carry1;
+
+                const int index = row_start + word;
+                m_counts[0][index] = sum0;
+                m_counts[1][index] = sum1;
+                m_counts[2][index] = sum2;
+                m_counts[3][index] = sum3;
+            }
+        }
+    }
+
+    /**
+     * Same as Game::clear_safe_zone(), drawing the same random numbers in the same order. The counts aren't made yet,
+     * so it only moves the mine bits.
+     */
+    void clear_safe_zone(const int x, const int y) {
+        const auto in_safe_zone = [x, y](const int i, const int j) {
+            return std::abs(i - x) <= 1 && std::abs(j - y) <= 1;
+        };
+
+        int zone_mines_count = 0;
+        int zone_size = 0;
+
+        for (int j = std::max(y - 1, 0); j <= std::min(y + 1, m_rows - 1); j++)
+            for (int i = std::max(x - 1, 0); i <= std::min(x + 1, m_columns - 1); i++) {
+                zone_size++;
+
+                if (!is_mine(i, j))
+                    continue;
+
+                m_mines[word_index(i, j)] &= ~bit_mask(i);
+                zone_mines_count++;
+            }
+
+        if (zone_mines_count == 0)
+            return;
+
+        CounterRandom random(CounterRandom::mix(m_seed));
+        const int cells = m_rows * m_columns;
+        const int free_cells = cells - zone_size - (m_total_mines - zone_mines_count);
+
+        std::vector<int> candidates;
+        const bool crowded = free_cells * SAFE_ZONE_CROWDED_RATIO < cells;
+
+        if (crowded)
+            for (int j = 0; j < m_rows; j++)
+                for (int i = 0; i < m_columns; i++)
+                    if (!is_mine(i, j) && !in_safe_zone(i, j))
+                        candidates.push_back(j * m_columns + i);
+
+        for (int k = 0; k < zone_mines_count; k++) {
+            int target;
+
+            if (crowded) {
+                const int position = random.uniform(0, static_cast<int>(candidates.size()) - 1);
+                target = candidates[position];
+                candidates[position] = candidates.back();
+                candidates.pop_back();
+            } else {
+                do {
+                    target = random.uniform(0, cells - 1);
+                } while (is_mine(target % m_columns, target / m_columns)
+                    || in_safe_zone(target % m_columns, target / m_columns));
+            }
+
+            const int nx = target % m_columns;
+            m_mines[word_index(nx, target / m_columns)] |= bit_mask(nx);
+        }
+    }
+
+    [[nodiscard]] bool all_safe_cells_revealed() const {
+        int revealed_safe_cells = 0;
+
+        for (size_t i = 0; i < m_revealed.size(); i++)
+            revealed_safe_cells += popcount(m_revealed[i] & ~m_mines[i]);
+
+        return revealed_safe_cells == m_rows * m_columns - m_total_mines;
+    }
+
+    void lose() {
+        m_over = true;
+        m_won = false;
+    }
+
+    /**
+     * Same breadth-first flood fill as Game, over the cells already in m_revealed_cells
+     */
+    void reveal_empty_regions() {
+        for (size_t i = 0; i < m_revealed_cells.size(); i++) {
+            const auto [x, y, inside] = m_revealed_cells[i];
+            const int word = word_index(x, y);
+
+            if (count_at(word, bit_mask(x)) != Game::CELL_0)
+                continue;
+
+            for_each_neighbour(x, y, [this](const int nx, const int ny) {
+                const int neighbour_word = word_index(nx, ny);
+                const uint64_t neighbour_bit = bit_mask(nx);
+
+                if ((m_revealed[neighbour_word] | m_flagged[neighbour_word]) & neighbour_bit)
+                    return;
+
+                m_revealed[neighbour_word] |= neighbour_bit;
+                m_revealed_cells.push_back({nx, ny, true});
+            });
+        }
+    }
+};
@@ -1,13 +1,15 @@
 #pragma once
 
-#include <cmath>
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 #include <filesystem>
 #include <fstream>
-#include <random>
 #include <vector>
 
+#include "mine_sampler.hpp"
+#include "neighbour_count.hpp"
+#include "random.hpp"
 #include "settings.hpp"
 
 class Game {
@@ -32,6 +34,7 @@ public:
         DIFFIC_HARD,
         DIFFIC_HUGE,
         DIFFIC_HIGHEST,
+        DIFFIC_CUSTOM,
     };
 
     static constexpr int DIFFICULTIES = DIFFIC_HIGHEST + 1;
@@ -44,37 +47,60 @@ public:
         "Extreme",
     };
 
-    struct Measurements {
-        int cell_size = 0;
-        int grid_line_length = 0;
-        int grid_line_width = 0;
-        int grid_x_offset = 0;
-        int grid_y_offset = 0;
-        int grid_width = 0;
-        int grid_height = 0;
-    };
-
     struct GridCell {
         CellType type = CELL_0;
         bool flagged = false;
         bool revealed = false;
     };
 
-private:
+    struct GridCoords {
+        int x = -1;
+        int y = -1;
+        bool inside = false;
+    };
+
     struct Setting {
         const int rows;
         const int columns;
         const int mines;
     };
 
-    struct GridCoords {
-        int x = -1;
-        int y = -1;
-        bool inside = false;
+    static constexpr Setting DIFFICULTY_TO_SETTING[DIFFICULTIES] = {
+        {12, 22, 12},  // BEGINNER (LOWEST)
+        {7, 10, 10},   // EASY
+        {12, 22, 40},  // MEDIUM
+        {18, 32, 100}, // HARD
+        {27, 48, 220}, // HUGE
+        {18, 32, 150}, // EXTREME (HIGHEST)
     };
 
-    typedef std::vector<std::vector<GridCell>> grid_t;
+private:
+    /**
+     * Row-major cells with a one cell wide sentinel border around the board
+     */
+    typedef std::vector<GridCell> grid_t;
+
+public:
+    /**
+     * Mines and counts of a board that doesn't have its first click yet, see prepare_grid()
+     */
+    struct PreparedGrid {
+        uint64_t seed = 0;
+        grid_t grid{};
+    };
+
+private:
+
+    static constexpr GridCell SENTINEL_CELL = {CELL_0, false, true};
+    // Below one free cell in this many, clearing the safe zone lists the free cells instead of guessing them
+    static constexpr int SAFE_ZONE_CROWDED_RATIO = 8;
 
+    // Same order as m_neighbour_offsets
+    static constexpr int NEIGHBOUR_DX[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+    static constexpr int NEIGHBOUR_DY[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+
+    static constexpr uint32_t SAVE_FILE_MAGIC = 0x5057534d; // "MSWP"
+    static constexpr uint32_t SAVE_FILE_VERSION = 3;
     static constexpr auto SAVES_DIR_PATH = "saves/";
     static constexpr const char *SAVE_FILE_PATH_BY_DIFFICULTY[DIFFICULTIES] = {
         "saves/beginner.bin",
@@ -85,59 +111,88 @@ private:
         "saves/extreme.bin",
     };
 
-    static constexpr Setting DIFFICULTY_TO_SETTING[DIFFICULTIES] = {
-        {12, 22, 12},  // BEGINNER (LOWEST)
-        {7, 10, 10},   // EASY
-        {12, 22, 40},  // MEDIUM
-        {18, 32, 100}, // HARD
-        {27, 48, 220}, // HUGE
-        {18, 32, 150}, // EXTREME (HIGHEST)
-    };
-
     const int m_rows;
     const int m_columns;
+    const int m_stride;
+    const int m_neighbour_offsets[8];
     const int m_total_mines;
     const Difficulty m_difficulty;
+    uint64_t m_seed;
     int m_unrevealed_count;
     grid_t m_grid{};
+    std::vector<GridCoords> m_revealed_cells{};
     int m_flagged_mines = 0;
     time_t m_start_time = 0;
     bool m_over = false;
     bool m_won = false;
-    Measurements m_measurements{};
 
     Game(
         const int rows,
         const int columns,
         const int total_mines,
         const Difficulty difficulty,
+        const uint64_t seed,
         const int unrevealed_count,
         grid_t grid,
         const int flagged_mines,
-        const time_t time_elapsed,
-        const Measurements &measurements
+        const time_t time_elapsed
     ) : m_rows(rows),
         m_columns(columns),
+        m_stride(columns + 2),
+        m_neighbour_offsets{
+            -m_stride - 1, -m_stride, -m_stride + 1,
+            -1, 1,
+            m_stride - 1, m_stride, m_stride + 1,
+        },
         m_total_mines(total_mines),
         m_difficulty(difficulty),
+        m_seed(seed),
         m_unrevealed_count(unrevealed_count),
         m_grid(std::move(grid)),
         m_flagged_mines(flagged_mines),
-        m_start_time(time(nullptr) - time_elapsed),
-        m_measurements(measurements) {}
+        m_start_time(time(nullptr) - time_elapsed) {}
 
 public:
-    Game(const Difficulty difficulty, const int window_width, const int window_height) :
+    explicit Game(const Difficulty difficulty, const uint64_t seed = CounterRandom::make_seed()) :
         m_rows(DIFFICULTY_TO_SETTING[difficulty].rows),
         m_columns(DIFFICULTY_TO_SETTING[difficulty].columns),
+        m_stride(m_columns + 2),
+        m_neighbour_offsets{
+            -m_stride - 1, -m_stride, -m_stride + 1,
+            -1, 1,
+            m_stride - 1, m_stride, m_stride + 1,
+        },
         m_total_mines(DIFFICULTY_TO_SETTING[difficulty].mines),
         m_difficulty(difficulty),
+        m_seed(seed),
         m_unrevealed_count(m_rows * m_columns),
-        m_grid(m_columns, std::vector(m_rows, GridCell{})),
-        m_measurements(calculate_measurements(window_width, window_height)) {
+        m_grid(make_grid(m_rows, m_columns)) {
         delete_save(difficulty);
     }
 
+    /**
+     * Custom sized board, not bound to a save slot
+     */
+    Game(
+        const int rows,
+        const int columns,
+        const int total_mines,
+        const uint64_t seed = CounterRandom::make_seed()
+    ) :
+        m_rows(rows),
+        m_columns(columns),
+        m_stride(m_columns + 2),
+        m_neighbour_offsets{
+            -m_stride - 1, -m_stride, -m_stride + 1,
+            -1, 1,
+            m_stride - 1, m_stride, m_stride + 1,
+        },
+        m_total_mines(std::min(total_mines, MineSampler::max_mines(rows, columns))),
+        m_difficulty(DIFFIC_CUSTOM),
+        m_seed(seed),
+        m_unrevealed_count(m_rows * m_columns),
+        m_grid(make_grid(m_rows, m_columns)) {}
+
     ~Game() = default;
 
     [[nodiscard]] int get_rows() const {
@@ -152,6 +207,14 @@ public:
         return m_difficulty;
     }
 
+    [[nodiscard]] uint64_t get_seed() const {
+        return m_seed;
+    }
+
+    [[nodiscard]] int get_total_mines() const {
+        return m_total_mines;
+    }
+
     [[nodiscard]] int get_remaining_mines() const {
         return m_total_mines - m_flagged_mines;
     }
@@ -164,12 +227,11 @@ public:
         return m_start_time != 0;
     }
 
-    [[nodiscard]] const Measurements &get_measurements() const {
-        return m_measurements;
-    }
-
+    /**
+     * Coordinates one cell outside the board are valid and return a revealed sentinel cell
+     */
     [[nodiscard]] const GridCell &get_grid_cell(const int x, const int y) const {
-        return m_grid[x][y];
+        return m_grid[cell_index(x, y)];
     }
 
     [[nodiscard]] bool is_over() const {
@@ -180,62 +242,56 @@ public:
         return m_won;
     }
 
-    void place_grid_mines(const int x, const int y) {
-        const time_t now = time(nullptr);
-        m_start_time = now;
-
-        std::mt19937_64 random_number_generator_engine{std::random_device{}()};
-        std::uniform_int_distribution<char> random_number_generator;
-
-        int placed_mines = 0;
-        while (placed_mines < m_total_mines) {
-            const int nx = random_number_generator(random_number_generator_engine) % m_columns;
-            const int ny = random_number_generator(random_number_generator_engine) % m_rows;
+    /**
+     * The layout only depends on the seed, the board size and (x, y)
+     */
+    void place_grid_mines(const int x, const int y, const uint64_t seed) {
+        m_seed = seed;
+        place_grid_mines(x, y);
+    }
 
-            // Mines count at (x, y) must be 0
-            if (nx >= x - 1 && nx <= x + 1 && ny >= y - 1 && ny <= y + 1)
-                continue;
+    void place_grid_mines(const int x, const int y) {
+        place_grid_mines(x, y, prepare_grid(m_rows, m_columns, m_total_mines, m_seed));
+    }
 
-            if (m_grid[nx][ny].type == CELL_0) {
-                m_grid[nx][ny].type = CELL_MINE;
-                placed_mines++;
-            }
-        }
+    /**
+     * Starts the game from a prepared grid of the same size, moving the mines around (x, y) out of the way
+     */
+    void place_grid_mines(const int x, const int y, PreparedGrid prepared) {
+        m_seed = prepared.seed;
+        m_grid = std::move(prepared.grid);
+        m_start_time = time(nullptr);
 
-        // Count surrounding mines
-        for (int i = 0; i < m_columns; i++) {
-            for (int j = 0; j < m_rows; j++) {
-                const CellType cell = m_grid[i][j].type;
-                if (cell == CELL_MINE)
-                    continue;
+        // Mines count at (x, y) must be 0
+        clear_safe_zone(x, y);
+    }
 
-                const CellType surrounding = count_surrounding_mines(i, j);
-                m_grid[i][j].type = surrounding;
-            }
-        }
+    /**
+     * Places a ready-made layout of row-major mine indices (y * columns + x), e.g. a no-guess board
+     */
+    void place_grid_mines(const std::vector<int> &mines) {
+        m_start_time = time(nullptr);
+        place_mines(m_grid, m_rows, m_columns, mines);
     }
 
-    [[nodiscard]] GridCoords calculate_grid_cell(const int click_x, const int click_y) const {
-        const int cell_size = m_measurements.cell_size;
-        const int grid_x_offset = m_measurements.grid_x_offset;
-        const int grid_y_offset = m_measurements.grid_y_offset;
+    /**
+     * Places and counts every mine with no regard for the first click, which is the costly part of starting a game.
+     * It doesn't touch any Game, so it can run on another thread while the board waits for its first click.
+     */
+    static PreparedGrid prepare_grid(const int rows, const int columns, const int mines, const uint64_t seed) {
+        CounterRandom random(seed);
+        PreparedGrid prepared{seed, make_grid(rows, columns)};
 
-        bool inside = true;
-        float x = static_cast<float>(click_x - grid_x_offset) / cell_size;
-        float y = static_cast<float>(click_y - grid_y_offset) / cell_size;
-        if (x < 0 || x > m_columns - 0.01f || y < 0 || y > m_rows - 0.01f) {
-            x = -1;
-            y = -1;
-            inside = false;
-        }
+        place_mines(prepared.grid, rows, columns, MineSampler::sample(rows, columns, mines, random));
 
-        return {static_cast<int>(x), static_cast<int>(y), inside};
+        return prepared;
     }
 
     void toggle_cell_flag(const int x, const int y) {
-        const auto [type, flagged, revealed] = m_grid[x][y];
+        const int index = cell_index(x, y);
+        const auto [type, flagged, revealed] = m_grid[index];
         if (!revealed) {
-            m_grid[x][y].flagged = !flagged;
+            m_grid[index].flagged = !flagged;
 
             if (!flagged)
                 m_flagged_mines++;
@@ -248,77 +304,78 @@ public:
         if (!Settings::is_on(Settings::EASY_FLAG) || type < CELL_1 || type > CELL_8)
             return;
 
-        GridCoords unrevealed[9];
-        const int unrevealed_count = get_surrounding_unrevealed(x, y, unrevealed);
+        int unrevealed[8];
+        const int unrevealed_count = get_surrounding_unrevealed(index, unrevealed);
 
         if (unrevealed_count != type - CELL_0)
             return;
 
         for (int i = 0; i < unrevealed_count; i++) {
-            const int nx = unrevealed[i].x;
-            const int ny = unrevealed[i].y;
+            GridCell &cell = m_grid[unrevealed[i]];
 
-            if (m_grid[nx][ny].flagged)
+            if (cell.flagged)
                 continue;
 
-            m_grid[nx][ny].flagged = true;
+            cell.flagged = true;
             m_flagged_mines++;
         }
     }
 
-    void reveal_cell(const int x, const int y) {
-        const auto [type, flagged, revealed] = m_grid[x][y];
+    /**
+     * Returns the cells revealed by this call, valid until the next one
+     */
+    const std::vector<GridCoords> &reveal_cell(const int x, const int y) {
+        const int index = cell_index(x, y);
+        const auto [type, flagged, revealed] = m_grid[index];
+
+        m_revealed_cells.clear();
 
         if (flagged)
-            return;
+            return m_revealed_cells;
 
         if (type == CELL_MINE) {
-            m_grid[x][y].revealed = true;
+            m_grid[index].revealed = true;
+            m_revealed_cells.push_back({x, y, true});
             m_over = true;
             m_won = false;
-            return;
+            return m_revealed_cells;
         }
 
-        GridCoords revealed_cells[9] = {{x, y}};
-        int revealed_cells_count = 1;
-
         if (revealed) {
             if (type < CELL_1 || type > CELL_8 || !Settings::is_on(Settings::EASY_DIG))
-                return;
+                return m_revealed_cells;
 
-            const int flagged_count = count_surrounding_flagged(x, y);
+            const int flagged_count = count_surrounding_flagged(index);
 
             if (flagged_count != type - CELL_0)
-                return;
+                return m_revealed_cells;
 
-            if (reveal_non_flagged(x, y, revealed_cells, &revealed_cells_count)) {
+            if (reveal_non_flagged(x, y)) {
+                m_unrevealed_count -= static_cast<int>(m_revealed_cells.size()) - 1;
                 m_over = true;
                 m_won = false;
-                return;
+                return m_revealed_cells;
             }
         } else {
-            m_grid[x][y].revealed = true;
-            m_unrevealed_count--;
+            m_grid[index].revealed = true;
+            m_revealed_cells.push_back({x, y, true});
         }
 
-        for (int i = 0; i < revealed_cells_count; i++) {
-            const int nx = revealed_cells[i].x;
-            const int ny = revealed_cells[i].y;
-
-            if (m_grid[nx][ny].type != CELL_0)
-                continue;
-
-            reveal_cell_border(nx, ny);
-            reveal_cells_dfs(nx, ny);
-        }
+        reveal_empty_regions();
+        m_unrevealed_count -= static_cast<int>(m_revealed_cells.size());
 
         if (m_total_mines == m_unrevealed_count) {
             m_over = true;
             m_won = true;
         }
+
+        return m_revealed_cells;
     }
 
     void save() const {
+        if (m_difficulty == DIFFIC_CUSTOM)
+            return;
+
         const time_t time_elapsed = time(nullptr) - m_start_time;
 
         if (!std::filesystem::exists(SAVES_DIR_PATH))
@@ -326,16 +383,19 @@ public:
 
         std::ofstream save_file(SAVE_FILE_PATH_BY_DIFFICULTY[m_difficulty], std::ios::binary | std::ios::out);
 
+        save_file.write(reinterpret_cast<const char *>(&SAVE_FILE_MAGIC), sizeof(SAVE_FILE_MAGIC));
+        save_file.write(reinterpret_cast<const char *>(&SAVE_FILE_VERSION), sizeof(SAVE_FILE_VERSION));
+        save_file.write(reinterpret_cast<const char *>(&m_seed), sizeof(m_seed));
         save_file.write(reinterpret_cast<const char *>(&m_rows), sizeof(m_rows));
         save_file.write(reinterpret_cast<const char *>(&m_columns), sizeof(m_columns));
         save_file.write(reinterpret_cast<const char *>(&m_total_mines), sizeof(m_total_mines));
         save_file.write(reinterpret_cast<const char *>(&m_unrevealed_count), sizeof(m_unrevealed_count));
         save_file.write(reinterpret_cast<const char *>(&m_flagged_mines), sizeof(m_flagged_mines));
         save_file.write(reinterpret_cast<const char *>(&time_elapsed), sizeof(time_elapsed));
-        save_file.write(reinterpret_cast<const char *>(&m_measurements), sizeof(m_measurements));
 
-        for (const auto &column : m_grid)
-            for (const auto &[type, flagged, revealed] : column) {
+        for (int i = 0; i < m_columns; i++)
+            for (int j = 0; j < m_rows; j++) {
+                const auto &[type, flagged, revealed] = get_grid_cell(i, j);
                 const char data = flagged << 7 | revealed << 6 | type;
                 save_file.write(&data, sizeof(data));
             }
@@ -343,30 +403,48 @@ public:
         save_file.close();
     }
 
+    /**
+     * Saves written by other versions of the format are ignored
+     */
     static bool save_exists(const Difficulty difficulty) {
         const char *path = SAVE_FILE_PATH_BY_DIFFICULTY[difficulty];
-        return std::filesystem::exists(path) && !std::filesystem::is_empty(path);
+
+        if (!std::filesystem::exists(path) || std::filesystem::is_empty(path))
+            return false;
+
+        std::ifstream save_file(path, std::ios::binary | std::ios::in);
+
+        uint32_t magic = 0, version = 0;
+        save_file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+        save_file.read(reinterpret_cast<char *>(&version), sizeof(version));
+
+        return magic == SAVE_FILE_MAGIC && version == SAVE_FILE_VERSION;
     }
 
     static Game load(const Difficulty difficulty) {
         std::ifstream save_file(SAVE_FILE_PATH_BY_DIFFICULTY[difficulty], std::ios::binary | std::ios::in);
 
+        uint32_t magic, version;
+        uint64_t seed;
         int rows, columns, total_mines, unrevealed_count, flagged_mines;
         time_t time_elapsed;
-        Measurements measurements;
 
+        save_file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+        save_file.read(reinterpret_cast<char *>(&version), sizeof(version));
+        save_file.read(reinterpret_cast<char *>(&seed), sizeof(seed));
         save_file.read(reinterpret_cast<char *>(&rows), sizeof(rows));
         save_file.read(reinterpret_cast<char *>(&columns), sizeof(columns));
         save_file.read(reinterpret_cast<char *>(&total_mines), sizeof(total_mines));
         save_file.read(reinterpret_cast<char *>(&unrevealed_count), sizeof(unrevealed_count));
         save_file.read(reinterpret_cast<char *>(&flagged_mines), sizeof(flagged_mines));
         save_file.read(reinterpret_cast<char *>(&time_elapsed), sizeof(time_elapsed));
-        save_file.read(reinterpret_cast<char *>(&measurements), sizeof(measurements));
 
-        grid_t grid(columns, std::vector(rows, GridCell{}));
+        grid_t grid = make_grid(rows, columns);
 
-        for (auto &column : grid)
-            for (auto &[type, flagged, revealed] : column) {
+        // Saved in column-major order
+        for (int i = 0; i < columns; i++)
+            for (int j = 0; j < rows; j++) {
+                auto &[type, flagged, revealed] = grid[(j + 1) * (columns + 2) + i + 1];
                 char data;
                 save_file.read(&data, sizeof(data));
                 flagged = data >> 7 & 1;
@@ -382,225 +460,223 @@ public:
             columns,
             total_mines,
             difficulty,
+            seed,
             unrevealed_count,
             grid,
             flagged_mines,
-            time_elapsed,
-            measurements
+            time_elapsed
         };
     }
 
 private:
-    static void delete_save(const Difficulty difficulty) {
-        if (save_exists(difficulty))
-            std::filesystem::remove(SAVE_FILE_PATH_BY_DIFFICULTY[difficulty]);
-    }
+    static grid_t make_grid(const int rows, const int columns) {
+        const int stride = columns + 2;
+        grid_t grid(stride * (rows + 2), GridCell{});
 
-    [[nodiscard]] Measurements calculate_measurements(const int window_width, const int window_height) const {
-        const float grid_ratio = static_cast<double>(m_columns) / m_rows;
-        const float window_ratio = static_cast<double>(window_width) / window_height;
+        for (int i = 0; i < stride; i++) {
+            grid[i] = SENTINEL_CELL;
+            grid[(rows + 1) * stride + i] = SENTINEL_CELL;
+        }
 
-        const int limitant_grid_side = grid_ratio > window_ratio ? m_columns : m_rows;
-        const int limitant_window_side = grid_ratio > window_ratio ? window_width : window_height;
-        const int cell_size = lround(limitant_window_side * 0.875 / limitant_grid_side);
+        for (int j = 1; j <= rows; j++) {
+            grid[j * stride] = SENTINEL_CELL;
+            grid[j * stride + columns + 1] = SENTINEL_CELL;
+        }
 
-        const int grid_line_length = cell_size * 0.65;
-        const int grid_line_width = lround(cell_size * 0.03);
-        const int grid_width = cell_size * m_columns;
-        const int grid_x_offset = (window_width - grid_width) / 2;
-        const int grid_height = cell_size * m_rows;
-        const int grid_y_offset = lround((window_height - grid_height) / 2.0 + window_height * 0.0375);
+        return grid;
+    }
 
-        return {
-            cell_size,
-            grid_line_length,
-            grid_line_width,
-            grid_x_offset,
-            grid_y_offset,
-            grid_width,
-            grid_height,
-        };
+    [[nodiscard]] int cell_index(const int x, const int y) const {
+        return (y + 1) * m_stride + x + 1;
     }
 
-    [[nodiscard]] CellType count_surrounding_mines(const int x, const int y) const {
-        int surrounding = CELL_0;
+    static void place_mines(grid_t &grid, const int rows, const int columns, const std::vector<int> &mines) {
+        const int stride = columns + 2;
 
-        for (int i = -1; i <= 1; i++) {
-            const int nx = x + i;
+        for (const int mine : mines)
+            grid[(mine / columns + 1) * stride + mine % columns + 1].type = CELL_MINE;
 
-            if (nx < 0 || nx > m_columns - 1)
-                continue;
+        // Count surrounding mines, the mask shares the grid layout and its zeroed sentinel border
+        std::vector<uint8_t> mines_mask(grid.size(), 0);
+        std::vector<uint8_t> mines_count(grid.size(), 0);
+
+        for (size_t i = 0; i < grid.size(); i++)
+            mines_mask[i] = grid[i].type == CELL_MINE;
+
+        NeighbourCount::box_sum(mines_mask.data(), mines_count.data(), rows, columns);
 
-            for (int j = -1; j <= 1; j++) {
-                const int ny = y + j;
+        for (int j = 0; j < rows; j++) {
+            const int row_index = (j + 1) * stride + 1;
 
-                if (ny < 0 || ny > m_rows - 1)
+            for (int i = 0; i < columns; i++) {
+                GridCell &cell = grid[row_index + i];
+                if (cell.type == CELL_MINE)
                     continue;
 
-                if (m_grid[nx][ny].type == CELL_MINE)
-                    surrounding++;
+                cell.type = static_cast<CellType>(mines_count[row_index + i]);
             }
         }
-
-        return static_cast<CellType>(surrounding);
     }
 
-    int get_surrounding_unrevealed(const int x, const int y, GridCoords coords[9]) const {
-        int count = 0;
+    /**
+     * Moves the mines of the 3x3 zone around (x, y) to random free cells outside of it. The mines already outside
+     * are a uniform pick of those cells, so the board ends up as uniform as if the zone had been skipped from the
+     * start. Only the counts around the moved mines change.
+     */
+    void clear_safe_zone(const int x, const int y) {
+        const auto in_safe_zone = [x, y](const int i, const int j) {
+            return std::abs(i - x) <= 1 && std::abs(j - y) <= 1;
+        };
 
-        for (int i = -1; i <= 1; i++) {
-            const int nx = x + i;
+        int zone_mines[9];
+        int zone_mines_count = 0;
+        int zone_size = 0;
 
-            if (nx < 0 || nx > m_columns - 1)
-                continue;
+        for (int j = std::max(y - 1, 0); j <= std::min(y + 1, m_rows - 1); j++)
+            for (int i = std::max(x - 1, 0); i <= std::min(x + 1, m_columns - 1); i++) {
+                zone_size++;
 
-            for (int j = -1; j <= 1; j++) {
-                const int ny = y + j;
+                if (get_grid_cell(i, j).type == CELL_MINE)
+                    zone_mines[zone_mines_count++] = cell_index(i, j);
+            }
 
-                if (ny < 0 || ny > m_rows - 1 || m_grid[nx][ny].revealed)
-                    continue;
+        if (zone_mines_count == 0)
+            return;
 
-                coords[count++] = {nx, ny};
+        // Own stream, so the mines outside the zone stay the same for every first click
+        CounterRandom random(CounterRandom::mix(m_seed));
+        const int cells = m_rows * m_columns;
+        const int free_cells = cells - zone_size - (m_total_mines - zone_mines_count);
+
+        // Picking random cells until one is free takes cells / free_cells tries, too many on crowded boards
+        std::vector<int> candidates;
+        const bool crowded = free_cells * SAFE_ZONE_CROWDED_RATIO < cells;
+
+        if (crowded)
+            for (int j = 0; j < m_rows; j++)
+                for (int i = 0; i < m_columns; i++)
+                    if (get_grid_cell(i, j).type != CELL_MINE && !in_safe_zone(i, j))
+                        candidates.push_back(cell_index(i, j));
+
+        for (int k = 0; k < zone_mines_count; k++) {
+            int target;
+
+            if (crowded) {
+                const int position = random.uniform(0, static_cast<int>(candidates.size()) - 1);
+                target = candidates[position];
+                candidates[position] = candidates.back();
+                candidates.pop_back();
+            } else {
+                int i, j;
+
+                do {
+                    const int rank = random.uniform(0, cells - 1);
+                    i = rank % m_columns;
+                    j = rank / m_columns;
+                } while (get_grid_cell(i, j).type == CELL_MINE || in_safe_zone(i, j));
+
+                target = cell_index(i, j);
             }
-        }
 
-        return count;
+            move_mine(zone_mines[k], target);
+        }
     }
 
-    bool reveal_non_flagged(const int x, const int y, GridCoords coords[9], int *counter) {
-        bool revealed_mine = false;
-
-        for (int i = -1; i <= 1; i++) {
-            const int nx = x + i;
-
-            if (nx < 0 || nx > m_columns - 1)
-                continue;
-
-            for (int j = -1; j <= 1; j++) {
-                const int ny = y + j;
+    /**
+     * Before the first click only the sentinels are revealed, so they're the ones skipped
+     */
+    void move_mine(const int from, const int to) {
+        int from_count = 0;
 
-                if (ny < 0 || ny > m_rows - 1)
-                    continue;
-
-                const auto [type, flagged, revealed] = m_grid[nx][ny];
-
-                if (revealed || flagged)
-                    continue;
-
-                coords[*counter] = {nx, ny};
-                *counter = *counter + 1;
+        for (const int offset : m_neighbour_offsets) {
+            GridCell &cell = m_grid[from + offset];
 
-                if (type != CELL_MINE)
-                    m_unrevealed_count--;
+            if (cell.type == CELL_MINE)
+                from_count++;
+            else if (!cell.revealed)
+                cell.type = static_cast<CellType>(cell.type - 1);
+        }
 
-                m_grid[nx][ny].revealed = true;
+        m_grid[from].type = static_cast<CellType>(from_count);
 
-                if (type == CELL_MINE) {
-                    revealed_mine = true;
-                    break;
-                }
-            }
+        for (const int offset : m_neighbour_offsets) {
+            GridCell &cell = m_grid[to + offset];
 
-            if (revealed_mine)
-                break;
+            if (cell.type != CELL_MINE && !cell.revealed)
+                cell.type = static_cast<CellType>(cell.type + 1);
         }
 
-        return revealed_mine;
+        m_grid[to].type = CELL_MINE;
     }
 
-    [[nodiscard]] int count_surrounding_flagged(const int x, const int y) const {
-        int flagged = 0;
-        for (int i = -1; i <= 1; i++) {
-            const int nx = x + i;
-
-            if (nx < 0 || nx > m_columns - 1)
-                continue;
+    static void delete_save(const Difficulty difficulty) {
+        if (difficulty != DIFFIC_CUSTOM && std::filesystem::exists(SAVE_FILE_PATH_BY_DIFFICULTY[difficulty]))
+            std::filesystem::remove(SAVE_FILE_PATH_BY_DIFFICULTY[difficulty]);
+    }
 
-            for (int j = -1; j <= 1; j++) {
-                const int ny = y + j;
+    int get_surrounding_unrevealed(const int index, int cells[8]) const {
+        int count = 0;
 
-                if (ny < 0 || ny > m_rows - 1 || m_grid[nx][ny].revealed || !m_grid[nx][ny].flagged)
-                    continue;
+        for (const int offset : m_neighbour_offsets) {
+            if (m_grid[index + offset].revealed)
+                continue;
 
-                flagged++;
-            }
+            cells[count++] = index + offset;
         }
 
-        return flagged;
+        return count;
     }
 
-    [[nodiscard]] GridCoords get_surrounding_empty(const int x, const int y) const {
-        GridCoords coords{};
+    bool reveal_non_flagged(const int x, const int y) {
+        const int index = cell_index(x, y);
 
-        for (int i = -1; i <= 1; i++) {
-            const int nx = x + i;
+        for (int i = 0; i < 8; i++) {
+            GridCell &cell = m_grid[index + m_neighbour_offsets[i]];
 
-            if (nx < 0 || nx > m_columns - 1)
+            if (cell.revealed || cell.flagged)
                 continue;
 
-            bool found = false;
-
-            for (int j = -1; j <= 1; j++) {
-                const int ny = y + j;
+            cell.revealed = true;
+            m_revealed_cells.push_back({x + NEIGHBOUR_DX[i], y + NEIGHBOUR_DY[i], true});
 
-                if (ny < 0 || ny > m_rows - 1 || m_grid[nx][ny].type != CELL_0 || m_grid[nx][ny].revealed)
-                    continue;
-
-                coords.x = nx;
-                coords.y = ny;
-                found = true;
-                break;
-            }
-
-            if (found)
-                break;
+            if (cell.type == CELL_MINE)
+                return true;
         }
 
-        return coords;
+        return false;
     }
 
-    void reveal_cells_dfs(const int x, const int y) { // NOLINT(*-no-recursion)
-        for (int i = -1; i <= 1; i++) {
-            const int nx = x + i;
-
-            if (nx < 0 || nx > m_columns - 1)
-                continue;
-
-            for (int j = -1; j <= 1; j++) {
-                // Do not check corners
-                if (abs(x) == 1 && abs(y) == 1)
-                    continue;
-
-                const int ny = y + j;
-
-                if (ny < 0 || ny > m_rows - 1 || m_grid[nx][ny].type != CELL_0 || m_grid[nx][ny].revealed)
-                    continue;
+    [[nodiscard]] int count_surrounding_flagged(const int index) const {
+        int flagged = 0;
 
-                m_grid[nx][ny].revealed = true;
-                m_unrevealed_count--;
-                reveal_cell_border(nx, ny);
-                reveal_cells_dfs(nx, ny);
-            }
+        for (const int offset : m_neighbour_offsets) {
+            const GridCell &cell = m_grid[index + offset];
+            flagged += !cell.revealed && cell.flagged;
         }
+
+        return flagged;
     }
 
-    void reveal_cell_border(const int x, const int y) {
-        for (int i = -1; i <= 1; i++) {
-            const int bx = x + i;
+    /**
+     * Breadth-first flood fill over the cells already in m_revealed_cells, which doubles as the work list.
+     * Each cell is revealed and queued at most once, and only empty cells expand to their neighbours.
+     */
+    void reveal_empty_regions() {
+        for (size_t i = 0; i < m_revealed_cells.size(); i++) {
+            const auto [x, y, inside] = m_revealed_cells[i];
+            const int index = cell_index(x, y);
 
-            if (bx < 0 || bx > m_columns - 1)
+            if (m_grid[index].type != CELL_0)
                 continue;
 
-            for (int j = -1; j <= 1; j++) {
-                const int by = y + j;
-                const CellType cell_type = m_grid[bx][by].type;
+            for (int j = 0; j < 8; j++) {
+                GridCell &cell = m_grid[index + m_neighbour_offsets[j]];
 
-                if (by < 0 || by > m_rows - 1 || m_grid[bx][by].revealed || cell_type == CELL_0 || cell_type ==
-                    CELL_MINE)
+                if (cell.revealed || cell.flagged)
                     continue;
 
-                m_grid[bx][by].revealed = true;
-                m_unrevealed_count--;
+                cell.revealed = true;
+                m_revealed_cells.push_back({x + NEIGHBOUR_DX[j], y + NEIGHBOUR_DY[j], true});
             }
         }
     }
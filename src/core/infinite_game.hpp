@@ -0,0 +1,316 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "game.hpp"
+#include "neighbour_count.hpp"
+#include "random.hpp"
+
+/**
+ * Board with no edges, stored in square chunks that only exist once something looks at them.
+ *
+ * Whether a cell is a mine only depends on the seed and its position, so the mines and counts of a chunk are
+ * generated on demand, and can be dropped and generated again at any time. The revealed and flagged cells are the
+ * only state that has to be kept. trim() cuts chunks far from the camera down to that, or drops them entirely if
+ * the player never touched them, so memory grows with the explored area instead of the size of the world.
+ *
+ * Empty regions can be arbitrarily large, so the flood fill reveals up to REVEAL_BUDGET cells per call and
+ * continue_reveal() picks it up where it stopped.
+ */
+class InfiniteGame {
+public:
+    typedef Game::GridCell GridCell;
+    typedef Game::GridCoords GridCoords;
+
+    static constexpr int CHUNK_SIZE = 32;
+    static constexpr float DEFAULT_DENSITY = 0.18f;
+    static constexpr int REVEAL_BUDGET = 4096;
+
+private:
+    static constexpr int CHUNK_AREA = CHUNK_SIZE * CHUNK_SIZE;
+    static constexpr int MASK_STRIDE = CHUNK_SIZE + 2;
+
+    // Same order as Game's neighbour offsets
+    static constexpr int NEIGHBOUR_DX[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+    static constexpr int NEIGHBOUR_DY[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+
+    struct Chunk {
+        std::bitset<CHUNK_AREA> revealed{};
+        std::bitset<CHUNK_AREA> flagged{};
+        // Game::CellType of every cell, empty while trimmed
+        std::vector<uint8_t> types{};
+
+        [[nodiscard]] bool is_touched() const {
+            return revealed.any() || flagged.any();
+        }
+    };
+
+    const uint64_t m_seed;
+    // Mine if the top 32 bits of a cell's random value are below this
+    const uint64_t m_mine_threshold;
+    std::unordered_map<uint64_t, Chunk> m_chunks{};
+    size_t m_loaded_chunks = 0;
+    std::vector<GridCoords> m_revealed_cells{};
+    // Revealed empty cells whose neighbours the flood fill hasn't revealed yet
+    std::deque<GridCoords> m_pending_cells{};
+    // First click, the 3x3 zone around it has no mines
+    GridCoords m_start{};
+    time_t m_start_time = 0;
+    int64_t m_revealed_count = 0;
+    int64_t m_flagged_count = 0;
+    bool m_over = false;
+
+public:
+    explicit InfiniteGame(const float density = DEFAULT_DENSITY, const uint64_t seed = CounterRandom::make_seed()) :
+        m_seed(seed),
+        m_mine_threshold(static_cast<uint64_t>(static_cast<double>(density) * (UINT64_C(1) << 32))) {}
+
+    ~InfiniteGame() = default;
+
+    [[nodiscard]] uint64_t get_seed() const {
+        return m_seed;
+    }
+
+    [[nodiscard]] time_t get_start_time() const {
+        return m_start_time;
+    }
+
+    [[nodiscard]] bool has_started() const {
+        return m_start.inside;
+    }
+
+    [[nodiscard]] bool is_over() const {
+        return m_over;
+    }
+
+    /**
+     * Whether the flood fill stopped at its budget and still has cells to reveal
+     */
+    [[nodiscard]] bool is_revealing() const {
+        return !m_pending_cells.empty();
+    }
+
+    [[nodiscard]] int64_t get_revealed_count() const {
+        return m_revealed_count;
+    }
+
+    [[nodiscard]] int64_t get_flagged_count() const {
+        return m_flagged_count;
+    }
+
+    /**
+     * Chunks kept in memory, trimmed or not
+     */
+    [[nodiscard]] size_t get_chunk_count() const {
+        return m_chunks.size();
+    }
+
+    [[nodiscard]] size_t get_loaded_chunk_count() const {
+        return m_loaded_chunks;
+    }
+
+    /**
+     * Coordinate of the chunk holding a cell coordinate, rounding towards negative infinity
+     */
+    static int chunk_coord(const int coord) {
+        return coord >= 0 ? coord / CHUNK_SIZE : (coord + 1) / CHUNK_SIZE - 1;
+    }
+
+    /**
+     * Generates the chunk of the cell if needed
+     */
+    [[nodiscard]] GridCell get_grid_cell(const int x, const int y) {
+        const Chunk &chunk = load_chunk(chunk_coord(x), chunk_coord(y));
+        const int index = local_index(x, y);
+
+        return {static_cast<Game::CellType>(chunk.types[index]), chunk.flagged[index], chunk.revealed[index]};
+    }
+
+    void toggle_cell_flag(const int x, const int y) {
+        Chunk &chunk = load_chunk(chunk_coord(x), chunk_coord(y));
+        const int index = local_index(x, y);
+
+        if (chunk.revealed[index])
+            return;
+
+        chunk.flagged.flip(index);
+        m_flagged_count += chunk.flagged[index] ? 1 : -1;
+    }
+
+    /**
+     * Returns the cells revealed by this call, valid until the next one. The first reveal is always safe.
+     */
+    const std::vector<GridCoords> &reveal_cell(const int x, const int y) {
+        m_revealed_cells.clear();
+
+        if (m_over)
+            return m_revealed_cells;
+
+        if (!has_started())
+            start(x, y);
+
+        Chunk &chunk = load_chunk(chunk_coord(x), chunk_coord(y));
+        const int index = local_index(x, y);
+
+        if (chunk.revealed[index] || chunk.flagged[index])
+            return m_revealed_cells;
+
+        reveal(chunk, index, x, y);
+
+        if (chunk.types[index] == Game::CELL_MINE) {
+            m_over = true;
+            m_pending_cells.clear();
+            return m_revealed_cells;
+        }
+
+        reveal_empty_regions();
+
+        return m_revealed_cells;
+    }
+
+    /**
+     * Reveals the next cells of an unfinished flood fill, see is_revealing()
+     */
+    const std::vector<GridCoords> &continue_reveal() {
+        m_revealed_cells.clear();
+        reveal_empty_regions();
+
+        return m_revealed_cells;
+    }
+
+    /**
+     * Drops the cached cells of every chunk further than radius chunks from the one holding (x, y), and the whole
+     * chunk if it was never touched
+     */
+    void trim(const int x, const int y, const int radius) {
+        const int center_x = chunk_coord(x);
+        const int center_y = chunk_coord(y);
+
+        for (auto it = m_chunks.begin(); it != m_chunks.end();) {
+            const auto [chunk_x, chunk_y] = unpack_key(it->first);
+            Chunk &chunk = it->second;
+
+            if (std::abs(chunk_x - center_x) <= radius && std::abs(chunk_y - center_y) <= radius) {
+                ++it;
+                continue;
+            }
+
+            if (!chunk.types.empty()) {
+                chunk.types.clear();
+                chunk.types.shrink_to_fit();
+                m_loaded_chunks--;
+            }
+
+            if (chunk.is_touched())
+                ++it;
+            else
+                it = m_chunks.erase(it);
+        }
+    }
+
+private:
+    static int local_index(const int x, const int y) {
+        return (y - chunk_coord(y) * CHUNK_SIZE) * CHUNK_SIZE + x - chunk_coord(x) * CHUNK_SIZE;
+    }
+
+    static uint64_t pack_key(const int chunk_x, const int chunk_y) {
+        return static_cast<uint64_t>(static_cast<uint32_t>(chunk_x)) << 32 | static_cast<uint32_t>(chunk_y);
+    }
+
+    static std::pair<int, int> unpack_key(const uint64_t key) {
+        return {static_cast<int32_t>(key >> 32), static_cast<int32_t>(key & UINT32_MAX)};
+    }
+
+    void start(const int x, const int y) {
+        m_start = {x, y, true};
+        m_start_time = time(nullptr);
+
+        // Cells generated before this point didn't know about the safe zone
+        for (auto &[key, chunk] : m_chunks)
+            chunk.types.clear();
+
+        m_loaded_chunks = 0;
+    }
+
+    /**
+     * Each chunk has its own stream of the seed, and each cell its own value of the stream
+     */
+    [[nodiscard]] bool is_mine(const int x, const int y) const {
+        if (has_started() && std::abs(x - m_start.x) <= 1 && std::abs(y - m_start.y) <= 1)
+            return false;
+
+        const CounterRandom random(m_seed ^ CounterRandom::mix(pack_key(chunk_coord(x), chunk_coord(y))));
+
+        return random.at(local_index(x, y)) >> 32 < m_mine_threshold;
+    }
+
+    Chunk &load_chunk(const int chunk_x, const int chunk_y) {
+        Chunk &chunk = m_chunks[pack_key(chunk_x, chunk_y)];
+
+        if (!chunk.types.empty())
+            return chunk;
+
+        // Mines of the chunk and a one cell wide ring of its neighbours, which the counts need too
+        uint8_t mines_mask[MASK_STRIDE * MASK_STRIDE];
+        uint8_t mines_count[MASK_STRIDE * MASK_STRIDE];
+        const int first_x = chunk_x * CHUNK_SIZE - 1;
+        const int first_y = chunk_y * CHUNK_SIZE - 1;
+
+        for (int j = 0; j < MASK_STRIDE; j++)
+            for (int i = 0; i < MASK_STRIDE; i++)
+                mines_mask[j * MASK_STRIDE + i] = is_mine(first_x + i, first_y + j);
+
+        NeighbourCount::box_sum(mines_mask, mines_count, CHUNK_SIZE, CHUNK_SIZE);
+
+        chunk.types.resize(CHUNK_AREA);
+
+        for (int j = 0; j < CHUNK_SIZE; j++)
+            for (int i = 0; i < CHUNK_SIZE; i++) {
+                const int mask_index = (j + 1) * MASK_STRIDE + i + 1;
+                chunk.types[j * CHUNK_SIZE + i] = mines_mask[mask_index]
+                    ? static_cast<uint8_t>(Game::CELL_MINE)
+                    : mines_count[mask_index];
+            }
+
+        m_loaded_chunks++;
+
+        return chunk;
+    }
+
+    void reveal(Chunk &chunk, const int index, const int x, const int y) {
+        chunk.revealed.set(index);
+        m_revealed_count++;
+        m_revealed_cells.push_back({x, y, true});
+
+        if (chunk.types[index] == Game::CELL_0)
+            m_pending_cells.push_back({x, y, true});
+    }
+
+    /**
+     * Breadth-first, like Game's, but the work list is kept between calls
+     */
+    void reveal_empty_regions() {
+        while (!m_pending_cells.empty() && m_revealed_cells.size() < REVEAL_BUDGET) {
+            const auto [x, y, inside] = m_pending_cells.front();
+            m_pending_cells.pop_front();
+
+            for (int i = 0; i < 8; i++) {
+                const int neighbour_x = x + NEIGHBOUR_DX[i];
+                const int neighbour_y = y + NEIGHBOUR_DY[i];
+                Chunk &chunk = load_chunk(chunk_coord(neighbour_x), chunk_coord(neighbour_y));
+                const int index = local_index(neighbour_x, neighbour_y);
+
+                if (chunk.revealed[index] || chunk.flagged[index])
+                    continue;
+
+                reveal(chunk, index, neighbour_x, neighbour_y);
+            }
+        }
+    }
+};
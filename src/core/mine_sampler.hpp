@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+#include "random.hpp"
+
+/**
+ * Static class for picking mine positions uniformly at random, optionally leaving the 3x3 zone around the first click
+ * empty.
+ *
+ * Runs a partial Fisher-Yates shuffle over the ranks of the eligible cells, storing only the swapped entries, so it
+ * takes O(mines) time and memory regardless of the board size or the mine density. Dense boards use a flat table
+ * of ranks instead, which is still O(mines) since mines make up over a quarter of the cells.
+ */
+class MineSampler {
+    static constexpr int DENSE_TABLE_RATIO = 4;
+
+public:
+    /**
+     * Highest amount of mines that still leaves room for the safe zone anywhere on the board
+     */
+    static int max_mines(const int rows, const int columns) {
+        return rows * columns - std::min(rows, 3) * std::min(columns, 3);
+    }
+
+    /**
+     * Returns the row-major indices (y * columns + x) of the mines
+     */
+    static std::vector<int> sample(
+        const int rows,
+        const int columns,
+        const int mines,
+        const int safe_x,
+        const int safe_y,
+        CounterRandom &random
+    ) {
+        // Sorted row-major indices of the safe zone
+        int safe_cells[9];
+        int safe_cells_count = 0;
+
+        for (int y = std::max(safe_y - 1, 0); y <= std::min(safe_y + 1, rows - 1); y++)
+            for (int x = std::max(safe_x - 1, 0); x <= std::min(safe_x + 1, columns - 1); x++)
+                safe_cells[safe_cells_count++] = y * columns + x;
+
+        return sample(rows * columns, mines, safe_cells, safe_cells_count, random);
+    }
+
+    /**
+     * Same as above, with no safe zone
+     */
+    static std::vector<int> sample(const int rows, const int columns, const int mines, CounterRandom &random) {
+        return sample(rows * columns, mines, nullptr, 0, random);
+    }
+
+private:
+    static std::vector<int> sample(
+        const int cells,
+        const int mines,
+        const int *safe_cells,
+        const int safe_cells_count,
+        CounterRandom &random
+    ) {
+        const int eligible = cells - safe_cells_count;
+        const int count = std::min(mines, eligible);
+
+        std::vector<int> sampled;
+        sampled.reserve(count);
+
+        if (count > eligible / DENSE_TABLE_RATIO) {
+            std::vector<int> ranks(eligible);
+            std::iota(ranks.begin(), ranks.end(), 0);
+
+            for (int i = 0; i < count; i++) {
+                std::swap(ranks[i], ranks[random.uniform(i, eligible - 1)]);
+                sampled.push_back(rank_to_index(ranks[i], safe_cells, safe_cells_count));
+            }
+
+            return sampled;
+        }
+
+        std::unordered_map<int, int> swapped;
+        swapped.reserve(count);
+
+        for (int i = 0; i < count; i++) {
+            const int j = random.uniform(i, eligible - 1);
+
+            const auto j_entry = swapped.find(j);
+            const int rank = j_entry != swapped.end() ? j_entry->second : j;
+
+            if (j != i) {
+                const auto i_entry = swapped.find(i);
+                swapped[j] = i_entry != swapped.end() ? i_entry->second : i;
+            }
+
+            sampled.push_back(rank_to_index(rank, safe_cells, safe_cells_count));
+        }
+
+        return sampled;
+    }
+
+    static int rank_to_index(const int rank, const int *safe_cells, const int safe_cells_count) {
+        int index = rank;
+
+        for (int i = 0; i < safe_cells_count; i++)
+            if (safe_cells[i] <= index)
+                index++;
+
+        return index;
+    }
+};
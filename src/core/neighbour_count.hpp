@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NEIGHBOUR_COUNT_X86
+#endif
+
+/**
+ * Static class for counting mines around every cell of a board at once.
+ *
+ * Boards are row-major byte masks with a one cell wide border of zeros, so the stride is columns + 2. Every count
+ * is the 3x3 box sum around a cell, center included, and only cells inside the border are written.
+ */
+class NeighbourCount {
+    typedef void (*kernel_t)(const uint8_t *mask, uint8_t *counts, int rows, int columns);
+
+public:
+    static void box_sum(const uint8_t *mask, uint8_t *counts, const int rows, const int columns) {
+        static const kernel_t kernel = select_kernel();
+        kernel(mask, counts, rows, columns);
+    }
+
+    static void box_sum_scalar(const uint8_t *mask, uint8_t *counts, const int rows, const int columns) {
+        const int stride = columns + 2;
+
+        for (int y = 1; y <= rows; y++)
+            box_sum_row_scalar(mask, counts, y * stride, 1, columns + 1, stride);
+    }
+
+#ifdef NEIGHBOUR_COUNT_X86
+    __attribute__((target("sse2")))
+    static void box_sum_sse2(const uint8_t *mask, uint8_t *counts, const int rows, const int columns) {
+        const int stride = columns + 2;
+
+        for (int y = 1; y <= rows; y++) {
+            const int row = y * stride;
+            int x = 1;
+
+            for (; x + 16 <= columns + 1; x += 16) {
+                __m128i sum = _mm_setzero_si128();
+
+                for (int dy = -stride; dy <= stride; dy += stride)
+                    for (int dx = -1; dx <= 1; dx++) {
+                        const auto *source = reinterpret_cast<const __m128i *>(mask + row + dy + x + dx);
+                        sum = _mm_add_epi8(sum, _mm_loadu_si128(source));
+                    }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(counts + row + x), sum);
+            }
+
+            box_sum_row_scalar(mask, counts, row, x, columns + 1, stride);
+        }
+    }
+
+    __attribute__((target("avx2")))
+    static void box_sum_avx2(const uint8_t *mask, uint8_t *counts, const int rows, const int columns) {
+        const int stride = columns + 2;
+
+        for (int y = 1; y <= rows; y++) {
+            const int row = y * stride;
+            int x = 1;
+
+            for (; x + 32 <= columns + 1; x += 32) {
+                __m256i sum = _mm256_setzero_si256();
+
+                for (int dy = -stride; dy <= stride; dy += stride)
+                    for (int dx = -1; dx <= 1; dx++) {
+                        const auto *source = reinterpret_cast<const __m256i *>(mask + row + dy + x + dx);
+                        sum = _mm256_add_epi8(sum, _mm256_loadu_si256(source));
+                    }
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(counts + row + x), sum);
+            }
+
+            box_sum_row_scalar(mask, counts, row, x, columns + 1, stride);
+        }
+    }
+#endif
+
+private:
+    static void box_sum_row_scalar(
+        const uint8_t *mask,
+        uint8_t *counts,
+        const int row,
+        const int from,
+        const int to,
+        const int stride
+    ) {
+        for (int x = from; x < to; x++) {
+            const int index = row + x;
+            const uint8_t *top = mask + index - stride;
+            const uint8_t *middle = mask + index;
+            const uint8_t *bottom = mask + index + stride;
+
+            counts[index] = top[-1] + top[0] + top[1]
+                    + middle[-1] + middle[0] + middle[1]
+                    + bottom[-1] + bottom[0] + bottom[1];
+        }
+    }
+
+    static kernel_t select_kernel() {
+#ifdef NEIGHBOUR_COUNT_X86
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            return box_sum_avx2;
+
+        if (__builtin_cpu_supports("sse2"))
+            return box_sum_sse2;
+#endif
+
+        return box_sum_scalar;
+    }
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+
+#include "game.hpp"
+#include "mine_sampler.hpp"
+#include "random.hpp"
+#include "solver.hpp"
+
+/**
+ * Static class for checking and finding boards that can be finished by logic alone from the first click.
+ *
+ * A board passes if the Solver, only ever revealing the cells it proved safe, reveals every safe cell. Boards that
+ * need the total amount of mines to finish are rejected too, so it's on the safe side.
+ */
+class NoGuessGenerator {
+public:
+    /**
+     * Whether the layout, as row-major mine indices, can be finished by logic alone from (x, y)
+     */
+    static bool is_solvable(const int rows, const int columns, const std::vector<int> &mines, const int x, const int y) {
+        Game game(rows, columns, static_cast<int>(mines.size()), 0);
+        game.place_grid_mines(mines);
+
+        return solve(game, x, y);
+    }
+
+    /**
+     * Row-major mask of every cell a layout can be started from and finished by logic alone.
+     * Starting cells must have no mines around them, and all the cells of an empty region open the same cells, so
+     * the solver only runs once per region.
+     */
+    static std::vector<bool> get_solvable_starts(const int rows, const int columns, const std::vector<int> &mines) {
+        Game layout(rows, columns, static_cast<int>(mines.size()), 0);
+        layout.place_grid_mines(mines);
+
+        std::vector<bool> starts(rows * columns, false);
+        std::vector<bool> tested(rows * columns, false);
+
+        for (int y = 0; y < rows; y++)
+            for (int x = 0; x < columns; x++) {
+                if (tested[y * columns + x] || layout.get_grid_cell(x, y).type != Game::CELL_0)
+                    continue;
+
+                Game game(rows, columns, static_cast<int>(mines.size()), 0);
+                game.place_grid_mines(mines);
+
+                Solver solver(game);
+                const std::vector<Game::GridCoords> &opened = game.reveal_cell(x, y);
+                std::vector<int> region;
+
+                for (const auto &[i, j, inside] : opened)
+                    if (game.get_grid_cell(i, j).type == Game::CELL_0)
+                        region.push_back(j * columns + i);
+
+                solver.update(opened);
+                const bool solvable = finish(game, solver);
+
+                for (const int index : region) {
+                    tested[index] = true;
+                    starts[index] = solvable;
+                }
+            }
+
+        return starts;
+    }
+
+    /**
+     * Tries the layouts of seeds.at(first) to seeds.at(last - 1) with the safe zone at (x, y), returning the first
+     * that's solvable, or an empty layout if none is
+     */
+    static std::vector<int> search(
+        const int rows,
+        const int columns,
+        const int mines,
+        const int x,
+        const int y,
+        const CounterRandom &seeds,
+        const uint64_t first,
+        const uint64_t last
+    ) {
+        for (uint64_t i = first; i < last; i++) {
+            CounterRandom random(seeds.at(i));
+            std::vector<int> layout = MineSampler::sample(rows, columns, mines, x, y, random);
+
+            if (is_solvable(rows, columns, layout, x, y))
+                return layout;
+        }
+
+        return {};
+    }
+
+private:
+    static bool solve(Game &game, const int x, const int y) {
+        Solver solver(game);
+        solver.update(game.reveal_cell(x, y));
+
+        return finish(game, solver);
+    }
+
+    /**
+     * Keeps revealing the cells proven safe until there are none left
+     */
+    static bool finish(Game &game, Solver &solver) {
+        while (!game.is_over() && !solver.get_safe_cells().empty()) {
+            const auto [x, y, inside] = solver.get_coords(solver.get_safe_cells().back());
+            solver.update(game.reveal_cell(x, y));
+        }
+
+        return game.has_won();
+    }
+};
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "game.hpp"
+#include "mine_sampler.hpp"
+#include "no_guess_generator.hpp"
+#include "random.hpp"
+#include "work_stealing_pool.hpp"
+
+/**
+ * No-guess layouts of every difficulty, generated ahead of time on background threads.
+ *
+ * Each layout comes with the mask of cells it can be started from. A layout also works for the mirrored clicks,
+ * by mirroring it, so a handful of them cover most first clicks and taking one is a lookup. Clicks no layout
+ * covers get a parallel search instead, which never blocks the caller.
+ */
+class NoGuessPool {
+    struct Layout {
+        std::vector<int> mines;
+        std::vector<bool> starts;
+    };
+
+    /**
+     * State shared by the tasks of a search for a single click
+     */
+    struct Search {
+        std::promise<std::vector<int>> promise{};
+        std::atomic<bool> done = false;
+        std::atomic<int> remaining_tasks = 0;
+    };
+
+    static constexpr int LAYOUTS_PER_DIFFICULTY = 4;
+    // Candidates a refill task tries before giving up until the next refill
+    static constexpr int REFILL_ATTEMPTS = 4096;
+    static constexpr int SEARCH_TASKS = 256;
+    static constexpr int SEARCH_ATTEMPTS_PER_TASK = 64;
+
+    const CounterRandom m_seeds;
+    std::atomic<uint64_t> m_next_seed = 0;
+    std::atomic<bool> m_stopping = false;
+    std::mutex m_mutex;
+    std::vector<Layout> m_layouts[Game::DIFFICULTIES];
+    int m_refilling[Game::DIFFICULTIES] = {};
+    // Last member, so the workers are joined before anything they use is destroyed
+    WorkStealingPool m_workers;
+
+public:
+    NoGuessPool() :
+        m_seeds(CounterRandom::make_seed()),
+        // Leave a core for the UI
+        m_workers(std::max(WorkStealingPool::default_threads(), 2u) - 1) {}
+
+    ~NoGuessPool() {
+        m_stopping = true;
+    }
+
+    static NoGuessPool &get_shared() {
+        static NoGuessPool pool;
+        return pool;
+    }
+
+    /**
+     * Starts generating layouts for a difficulty until it has a full pool
+     */
+    void prefill(const Game::Difficulty difficulty) {
+        std::lock_guard lock(m_mutex);
+
+        const int missing = LAYOUTS_PER_DIFFICULTY - static_cast<int>(m_layouts[difficulty].size())
+                - m_refilling[difficulty];
+
+        for (int i = 0; i < missing; i++) {
+            m_refilling[difficulty]++;
+            m_workers.submit([this, difficulty, seed = next_seed()] { refill(difficulty, seed); });
+        }
+    }
+
+    /**
+     * Takes a pooled layout that can be started from (x, y), if there's any
+     */
+    std::optional<std::vector<int>> take(const Game::Difficulty difficulty, const int x, const int y) {
+        const auto &[rows, columns, mines] = Game::DIFFICULTY_TO_SETTING[difficulty];
+        std::optional<std::vector<int>> taken;
+
+        {
+            std::lock_guard lock(m_mutex);
+            std::vector<Layout> &layouts = m_layouts[difficulty];
+
+            for (size_t i = 0; i < layouts.size() && !taken; i++)
+                for (int mirror = 0; mirror < 4; mirror++) {
+                    const int start_x = mirror & 1 ? columns - 1 - x : x;
+                    const int start_y = mirror & 2 ? rows - 1 - y : y;
+
+                    if (!layouts[i].starts[start_y * columns + start_x])
+                        continue;
+
+                    taken = mirror_layout(layouts[i].mines, rows, columns, mirror);
+                    layouts.erase(layouts.begin() + static_cast<long>(i));
+                    break;
+                }
+        }
+
+        prefill(difficulty);
+
+        return taken;
+    }
+
+    /**
+     * Searches a no-guess layout for a first click at (x, y) across all the workers. If none is found, the future
+     * gets a regular random layout instead.
+     */
+    std::future<std::vector<int>> search(const int rows, const int columns, const int mines, const int x, const int y) {
+        const auto search = std::make_shared<Search>();
+        search->remaining_tasks = SEARCH_TASKS;
+
+        const CounterRandom seeds(next_seed());
+
+        for (int i = 0; i < SEARCH_TASKS; i++)
+            m_workers.submit([this, search, seeds, rows, columns, mines, x, y, i] {
+                if (!search->done && !m_stopping) {
+                    const uint64_t first = static_cast<uint64_t>(i) * SEARCH_ATTEMPTS_PER_TASK;
+                    std::vector<int> layout = NoGuessGenerator::search(
+                        rows,
+                        columns,
+                        mines,
+                        x,
+                        y,
+                        seeds,
+                        first,
+                        first + SEARCH_ATTEMPTS_PER_TASK
+                    );
+
+                    if (!layout.empty() && !search->done.exchange(true))
+                        search->promise.set_value(std::move(layout));
+                }
+
+                if (--search->remaining_tasks == 0 && !search->done.exchange(true)) {
+                    CounterRandom random(seeds.at(SEARCH_TASKS * SEARCH_ATTEMPTS_PER_TASK));
+                    search->promise.set_value(MineSampler::sample(rows, columns, mines, x, y, random));
+                }
+            });
+
+        return search->promise.get_future();
+    }
+
+private:
+    uint64_t next_seed() {
+        return m_seeds.at(m_next_seed++);
+    }
+
+    void refill(const Game::Difficulty difficulty, const uint64_t seed) {
+        const auto &[rows, columns, mines] = Game::DIFFICULTY_TO_SETTING[difficulty];
+        CounterRandom random(seed);
+
+        for (int attempt = 0; attempt < REFILL_ATTEMPTS && !m_stopping; attempt++) {
+            const int x = random.uniform(0, columns - 1);
+            const int y = random.uniform(0, rows - 1);
+            std::vector<int> layout = MineSampler::sample(rows, columns, mines, x, y, random);
+
+            // Most candidates fail, so only map every start of the ones that pass
+            if (!NoGuessGenerator::is_solvable(rows, columns, layout, x, y))
+                continue;
+
+            std::vector<bool> starts = NoGuessGenerator::get_solvable_starts(rows, columns, layout);
+
+            std::lock_guard lock(m_mutex);
+            m_layouts[difficulty].push_back({std::move(layout), std::move(starts)});
+            m_refilling[difficulty]--;
+            return;
+        }
+
+        std::lock_guard lock(m_mutex);
+        m_refilling[difficulty]--;
+    }
+
+    static std::vector<int> mirror_layout(
+        const std::vector<int> &mines,
+        const int rows,
+        const int columns,
+        const int mirror
+    ) {
+        std::vector<int> mirrored;
+        mirrored.reserve(mines.size());
+
+        for (const int mine : mines) {
+            const int x = mine % columns;
+            const int y = mine / columns;
+            mirrored.push_back(
+                (mirror & 2 ? rows - 1 - y : y) * columns + (mirror & 1 ? columns - 1 - x : x)
+            );
+        }
+
+        return mirrored;
+    }
+};
@@ -0,0 +1,456 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include "random.hpp"
+#include "solver.hpp"
+
+/**
+ * Mine probability of every cell of a Game position, on top of a Solver.
+ *
+ * The frontier is split into independent components, the groups of cells linked by shared numbers. Every component
+ * is enumerated on its own by backtracking, counting its solutions by the amount of mines they use, and the counts
+ * are combined with the number of ways to place the remaining mines among the cells away from the frontier. The
+ * enumeration of a component only depends on its cells and numbers, so it's memoized across calls.
+ *
+ * Components that don't fit in the time budget are estimated from random solutions instead, and the result is
+ * flagged as not exact.
+ */
+class ProbabilityEngine {
+    /**
+     * Solution counts of a component by amount of mines, and how many of those have a mine in each cell
+     */
+    struct Solutions {
+        std::vector<int> cells{};
+        std::vector<double> counts{};
+        std::vector<std::vector<double>> mine_counts{};
+        bool exact = true;
+    };
+
+    /**
+     * Cells of a component in search order, and the numbers around them
+     */
+    struct Component {
+        std::vector<int> cells{};
+        std::vector<int> constraint_mines{};
+        std::vector<std::vector<int>> constraint_cells{};
+        std::vector<std::vector<int>> cell_constraints{};
+        std::vector<int> signature{};
+    };
+
+    typedef std::chrono::steady_clock Clock;
+
+    static constexpr auto DEFAULT_BUDGET = std::chrono::milliseconds(20);
+    // Search nodes between clock checks
+    static constexpr int CLOCK_CHECK_INTERVAL = 4096;
+    static constexpr int SAMPLES_PER_COMPONENT = 512;
+    static constexpr int SAMPLE_NODES_PER_CELL = 64;
+
+    const Solver &m_solver;
+    const Clock::duration m_budget;
+    std::map<std::vector<int>, Solutions> m_cache{};
+    std::vector<int> m_cell_marks;
+    std::vector<int> m_constraint_marks;
+    std::vector<int> m_local_indices;
+    std::vector<float> m_probabilities;
+    int m_mark = 0;
+    bool m_exact = true;
+
+public:
+    explicit ProbabilityEngine(const Solver &solver, const Clock::duration budget = DEFAULT_BUDGET) :
+        m_solver(solver),
+        m_budget(budget),
+        m_cell_marks(solver.get_stride() * (solver.get_rows() + 2), 0),
+        m_constraint_marks(m_cell_marks.size(), 0),
+        m_local_indices(m_cell_marks.size(), 0),
+        m_probabilities(solver.get_rows() * solver.get_columns(), 0) {}
+
+    /**
+     * False if the last call had to estimate some component
+     */
+    [[nodiscard]] bool is_exact() const {
+        return m_exact;
+    }
+
+    /**
+     * Row-major (y * columns + x) probability of a mine in every cell, revealed cells are 0
+     */
+    const std::vector<float> &probabilities() {
+        const Clock::time_point deadline = Clock::now() + m_budget;
+        const int columns = m_solver.get_columns();
+
+        std::map<std::vector<int>, Solutions> cache;
+        std::vector<const Solutions *> components;
+        m_exact = true;
+
+        for (const int cell : m_solver.get_frontier()) {
+            if (m_cell_marks[cell] == m_mark + 1)
+                continue;
+
+            Component component = build_component(cell);
+            auto entry = m_cache.find(component.signature);
+
+            if (entry == m_cache.end()) {
+                Solutions solutions = enumerate(component, deadline);
+                if (!solutions.exact)
+                    solutions = sample(component);
+
+                entry = m_cache.insert_or_assign(component.signature, std::move(solutions)).first;
+            }
+
+            m_exact = m_exact && entry->second.exact;
+            components.push_back(&cache.emplace(entry->first, std::move(entry->second)).first->second);
+        }
+
+        // Only keep the components of this position
+        m_cache = std::move(cache);
+        m_mark++;
+
+        std::fill(m_probabilities.begin(), m_probabilities.end(), 0.0f);
+
+        const int interior_cells = m_solver.get_unknown_count() - static_cast<int>(m_solver.get_frontier().size());
+        const int unknown_mines = m_solver.get_unknown_mines();
+        const std::vector<double> interior_weights = get_interior_weights(interior_cells, unknown_mines);
+        const size_t count = components.size();
+
+        // Most mines the components before each one can hold
+        std::vector<size_t> mines_before(count + 1, 0);
+
+        for (size_t c = 0; c < count; c++)
+            mines_before[c + 1] = mines_before[c] + components[c]->counts.size() - 1;
+
+        // tails[c][j]: weight of the positions of components c onwards and the interior, if j mines come before c
+        std::vector<std::vector<double>> tails(count + 1);
+        tails[count].assign(mines_before[count] + 1, 0);
+
+        for (size_t j = 0; j < tails[count].size() && j < interior_weights.size(); j++)
+            tails[count][j] = interior_weights[j];
+
+        for (size_t c = count; c-- > 0;) {
+            const std::vector<double> &counts = components[c]->counts;
+            tails[c].assign(mines_before[c] + 1, 0);
+
+            for (size_t j = 0; j < tails[c].size(); j++)
+                for (size_t k = 0; k < counts.size(); k++)
+                    tails[c][j] += counts[k] * tails[c + 1][j + k];
+        }
+
+        const double total = tails[0][0];
+        if (total == 0)
+            return m_probabilities;
+
+        // Solution counts of all the components before the current one, by amount of mines
+        std::vector<double> heads = {1.0};
+
+        for (size_t c = 0; c < count; c++) {
+            const Solutions &solutions = *components[c];
+
+            for (size_t k = 0; k < solutions.counts.size(); k++) {
+                double weight = 0;
+
+                for (size_t j = 0; j < heads.size(); j++)
+                    weight += heads[j] * tails[c + 1][j + k];
+
+                if (weight == 0)
+                    continue;
+
+                for (size_t i = 0; i < solutions.cells.size(); i++) {
+                    const auto [x, y, inside] = m_solver.get_coords(solutions.cells[i]);
+                    m_probabilities[y * columns + x] += static_cast<float>(solutions.mine_counts[k][i] * weight / total);
+                }
+            }
+
+            heads = convolve(heads, solutions.counts);
+        }
+
+        double interior_mines = 0;
+
+        for (size_t k = 0; k < heads.size() && k < interior_weights.size(); k++)
+            interior_mines += heads[k] * interior_weights[k] * (unknown_mines - static_cast<int>(k));
+
+        const float interior_probability = interior_cells == 0 ? 0 : interior_mines / total / interior_cells;
+
+        for (int y = 0; y < m_solver.get_rows(); y++)
+            for (int x = 0; x < columns; x++) {
+                const int index = m_solver.cell_index(x, y);
+                const Solver::CellState state = m_solver.get_state(index);
+
+                if (state == Solver::STATE_MINE)
+                    m_probabilities[y * columns + x] = 1;
+                else if (state == Solver::STATE_UNKNOWN && m_cell_marks[index] != m_mark)
+                    m_probabilities[y * columns + x] = interior_probability;
+            }
+
+        return m_probabilities;
+    }
+
+private:
+    /**
+     * Breadth-first walk from a frontier cell through the numbers it shares with other cells
+     */
+    Component build_component(const int start) {
+        const int *offsets = m_solver.get_neighbour_offsets();
+        const int mark = m_mark + 1;
+        Component component;
+
+        m_cell_marks[start] = mark;
+        component.cells.push_back(start);
+
+        for (size_t i = 0; i < component.cells.size(); i++) {
+            const int cell = component.cells[i];
+
+            for (int j = 0; j < 8; j++) {
+                const int constraint = cell + offsets[j];
+
+                if (m_solver.get_state(constraint) != Solver::STATE_REVEALED || m_constraint_marks[constraint] == mark)
+                    continue;
+
+                const Solver::Constraint numbers = m_solver.get_constraint(constraint);
+                if (numbers.size == 0)
+                    continue;
+
+                m_constraint_marks[constraint] = mark;
+                component.constraint_mines.push_back(numbers.mines);
+                component.constraint_cells.emplace_back(numbers.cells, numbers.cells + numbers.size);
+                component.signature.push_back(constraint);
+                component.signature.push_back(numbers.mines);
+
+                for (int k = 0; k < numbers.size; k++) {
+                    if (m_cell_marks[numbers.cells[k]] == mark)
+                        continue;
+
+                    m_cell_marks[numbers.cells[k]] = mark;
+                    component.cells.push_back(numbers.cells[k]);
+                }
+            }
+        }
+
+        // Local indices from here on
+        component.cell_constraints.resize(component.cells.size());
+
+        for (size_t i = 0; i < component.cells.size(); i++)
+            m_local_indices[component.cells[i]] = static_cast<int>(i);
+
+        for (size_t c = 0; c < component.constraint_cells.size(); c++)
+            for (int &cell : component.constraint_cells[c]) {
+                cell = m_local_indices[cell];
+                component.cell_constraints[cell].push_back(static_cast<int>(c));
+            }
+
+        // Numbers keep their value as their cells get deduced, so the cells are part of the signature too
+        component.signature.insert(component.signature.end(), component.cells.begin(), component.cells.end());
+
+        return component;
+    }
+
+    /**
+     * Shared state of the backtracking search over a component
+     */
+    struct Search {
+        const Component &component;
+        std::vector<int> needed;
+        std::vector<int> unassigned;
+        std::vector<int> values;
+        int mines = 0;
+
+        explicit Search(const Component &component) :
+            component(component),
+            needed(component.constraint_mines),
+            unassigned(component.constraint_cells.size()),
+            values(component.cells.size(), -1) {
+            for (size_t c = 0; c < component.constraint_cells.size(); c++)
+                unassigned[c] = static_cast<int>(component.constraint_cells[c].size());
+        }
+
+        /**
+         * Sets a cell and returns whether every number around it can still be satisfied, undoing it otherwise
+         */
+        bool assign(const int cell, const int value) {
+            bool valid = true;
+
+            for (const int c : component.cell_constraints[cell]) {
+                unassigned[c]--;
+                needed[c] -= value;
+                valid = valid && needed[c] >= 0 && needed[c] <= unassigned[c];
+            }
+
+            values[cell] = value;
+            mines += value;
+
+            if (!valid)
+                unassign(cell);
+
+            return valid;
+        }
+
+        void unassign(const int cell) {
+            const int value = values[cell];
+
+            for (const int c : component.cell_constraints[cell]) {
+                unassigned[c]++;
+                needed[c] += value;
+            }
+
+            values[cell] = -1;
+            mines -= value;
+        }
+
+        void record(Solutions &solutions) const {
+            solutions.counts[mines] += 1;
+
+            for (size_t i = 0; i < values.size(); i++)
+                solutions.mine_counts[mines][i] += values[i];
+        }
+    };
+
+    static Solutions make_solutions(const Component &component) {
+        const size_t size = component.cells.size();
+
+        Solutions solutions;
+        solutions.cells = component.cells;
+        solutions.counts.assign(size + 1, 0);
+        solutions.mine_counts.assign(size + 1, std::vector<double>(size, 0));
+
+        return solutions;
+    }
+
+    /**
+     * Iterative depth first search over every assignment, giving up at the deadline
+     */
+    static Solutions enumerate(const Component &component, const Clock::time_point deadline) {
+        const int size = static_cast<int>(component.cells.size());
+
+        Solutions solutions = make_solutions(component);
+        Search search(component);
+        // Next value to try at each depth, 2 once both were tried
+        std::vector<int> next_value(size + 1, 0);
+        int depth = 0;
+        long nodes = 0;
+
+        while (depth >= 0) {
+            if (++nodes % CLOCK_CHECK_INTERVAL == 0 && Clock::now() > deadline) {
+                solutions.exact = false;
+                return solutions;
+            }
+
+            if (depth == size) {
+                search.record(solutions);
+                depth--;
+                continue;
+            }
+
+            if (search.values[depth] != -1)
+                search.unassign(depth);
+
+            if (next_value[depth] == 2) {
+                next_value[depth] = 0;
+                depth--;
+                continue;
+            }
+
+            if (search.assign(depth, next_value[depth]++))
+                depth++;
+        }
+
+        normalize(solutions);
+        return solutions;
+    }
+
+    /**
+     * Random solutions found by a depth first search with a random value order, restarted after a node limit.
+     * Only an estimate, as solutions that are easier to reach get picked more often.
+     */
+    static Solutions sample(const Component &component) {
+        const int size = static_cast<int>(component.cells.size());
+
+        Solutions solutions = make_solutions(component);
+        solutions.exact = false;
+
+        CounterRandom random(CounterRandom::mix(component.signature.size() ^ component.cells.front()));
+        std::vector<int> first_value(size, 0);
+        std::vector<int> tries(size + 1, 0);
+
+        for (int sample = 0; sample < SAMPLES_PER_COMPONENT; sample++) {
+            Search search(component);
+            std::fill(tries.begin(), tries.end(), 0);
+            int depth = 0;
+
+            for (long nodes = 0; depth >= 0 && depth < size && nodes < size * SAMPLE_NODES_PER_CELL; nodes++) {
+                if (tries[depth] == 0)
+                    first_value[depth] = static_cast<int>(random() & 1);
+
+                if (search.values[depth] != -1)
+                    search.unassign(depth);
+
+                if (tries[depth] == 2) {
+                    tries[depth] = 0;
+                    depth--;
+                    continue;
+                }
+
+                if (search.assign(depth, first_value[depth] ^ tries[depth]++))
+                    depth++;
+            }
+
+            if (depth == size)
+                search.record(solutions);
+        }
+
+        normalize(solutions);
+        return solutions;
+    }
+
+    /**
+     * Scales the counts down so that convolving many components can't overflow, which doesn't change any ratio
+     */
+    static void normalize(Solutions &solutions) {
+        const double highest = *std::max_element(solutions.counts.begin(), solutions.counts.end());
+        if (highest == 0)
+            return;
+
+        for (size_t k = 0; k < solutions.counts.size(); k++) {
+            solutions.counts[k] /= highest;
+
+            for (double &count : solutions.mine_counts[k])
+                count /= highest;
+        }
+    }
+
+    static std::vector<double> convolve(const std::vector<double> &a, const std::vector<double> &b) {
+        std::vector<double> result(a.size() + b.size() - 1, 0);
+
+        for (size_t i = 0; i < a.size(); i++)
+            for (size_t j = 0; j < b.size(); j++)
+                result[i + j] += a[i] * b[j];
+
+        return result;
+    }
+
+    /**
+     * Ways to place the mines left by k frontier mines among the other cells, relative to the most likely k
+     */
+    static std::vector<double> get_interior_weights(const int cells, const int mines) {
+        std::vector<double> log_weights(mines + 1, -INFINITY);
+
+        for (int k = 0; k <= mines; k++) {
+            const int left = mines - k;
+            if (left > cells)
+                continue;
+
+            log_weights[k] = std::lgamma(cells + 1.0) - std::lgamma(left + 1.0) - std::lgamma(cells - left + 1.0);
+        }
+
+        const double highest = *std::max_element(log_weights.begin(), log_weights.end());
+        std::vector<double> weights(mines + 1, 0);
+
+        for (int k = 0; k <= mines; k++)
+            if (log_weights[k] != -INFINITY)
+                weights[k] = std::exp(log_weights[k] - highest);
+
+        return weights;
+    }
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+/**
+ * Counter-based pseudo random number generator (SplitMix64).
+ *
+ * The n-th value only depends on the seed and n, and uniform() doesn't go through the standard distributions,
+ * whose output differs between standard library implementations, so the same seed gives bit-identical sequences
+ * on every platform.
+ */
+class CounterRandom {
+    static constexpr uint64_t GOLDEN_GAMMA = 0x9e3779b97f4a7c15;
+
+    uint64_t m_seed;
+    uint64_t m_counter = 0;
+
+public:
+    using result_type = uint64_t;
+
+    explicit CounterRandom(const uint64_t seed) : m_seed(seed) {}
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return UINT64_MAX;
+    }
+
+    [[nodiscard]] uint64_t get_seed() const {
+        return m_seed;
+    }
+
+    [[nodiscard]] result_type at(const uint64_t counter) const {
+        return mix(m_seed + (counter + 1) * GOLDEN_GAMMA);
+    }
+
+    result_type operator()() {
+        return at(m_counter++);
+    }
+
+    /**
+     * Unbiased integer in [low, high], using Lemire's multiply and reject method
+     */
+    int uniform(const int low, const int high) {
+        const auto range = static_cast<uint32_t>(high - low) + 1;
+        uint64_t product = (operator()() >> 32) * range;
+        auto leftover = static_cast<uint32_t>(product);
+
+        if (leftover < range) {
+            const uint32_t threshold = -range % range;
+
+            while (leftover < threshold) {
+                product = (operator()() >> 32) * range;
+                leftover = static_cast<uint32_t>(product);
+            }
+        }
+
+        return low + static_cast<int>(product >> 32);
+    }
+
+    static uint64_t mix(uint64_t value) {
+        value = (value ^ value >> 30) * 0xbf58476d1ce4e5b9;
+        value = (value ^ value >> 27) * 0x94d049bb133111eb;
+        return value ^ value >> 31;
+    }
+
+    static uint64_t make_seed() {
+        std::random_device random_device;
+        return static_cast<uint64_t>(random_device()) << 32 | random_device();
+    }
+};
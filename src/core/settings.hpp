@@ -30,7 +30,7 @@ private:
         true,
     };
 
-    static bool settings[SETTINGS_AMOUNT];
+    static inline bool settings[SETTINGS_AMOUNT] = {};
 
 public:
     static void load() {
@@ -72,5 +72,3 @@ public:
         settings_file.close();
     }
 };
-
-bool Settings::settings[SETTINGS_AMOUNT] = {};
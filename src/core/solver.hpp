@@ -0,0 +1,348 @@
+#pragma once
+
+#include <vector>
+
+#include "game.hpp"
+
+/**
+ * Deduces safe cells and certain mines of a Game position, the way a player does.
+ *
+ * Every revealed number is a constraint on its hidden neighbours. Constraints are checked one by one (single point
+ * rule) and against every other constraint within two cells (subset rule), and a deduction only re-queues the
+ * constraints around the cell it changed, so each update costs time proportional to what it revealed and never
+ * rescans the board.
+ *
+ * Only revealed cells are used. Player flags may be wrong, so they never feed a deduction and flagging a cell
+ * doesn't need an update.
+ */
+class Solver {
+public:
+    enum CellState {
+        STATE_UNKNOWN,
+        STATE_SAFE,
+        STATE_MINE,
+        STATE_REVEALED,
+        STATE_BORDER,
+    };
+
+    /**
+     * Hidden neighbours of a constraint that aren't deduced yet, and the mines left among them
+     */
+    struct Constraint {
+        int cells[8];
+        int size = 0;
+        int mines = 0;
+    };
+
+private:
+    typedef Game::GridCoords GridCoords;
+
+    const Game &m_game;
+    const int m_rows;
+    const int m_columns;
+    const int m_stride;
+    const int m_neighbour_offsets[8];
+    // Row-major with a one cell wide border, same layout as the Game grid
+    std::vector<CellState> m_states;
+    std::vector<int> m_frontier_position;
+    std::vector<int> m_safe_position;
+    std::vector<bool> m_dirty;
+    std::vector<int> m_frontier{};
+    std::vector<int> m_safe_cells{};
+    std::vector<int> m_mine_cells{};
+    std::vector<int> m_worklist{};
+    int m_unknown_count;
+
+public:
+    /**
+     * Reads the cells the game already has revealed, e.g. after loading a save
+     */
+    explicit Solver(const Game &game) :
+        m_game(game),
+        m_rows(game.get_rows()),
+        m_columns(game.get_columns()),
+        m_stride(m_columns + 2),
+        m_neighbour_offsets{
+            -m_stride - 1, -m_stride, -m_stride + 1,
+            -1, 1,
+            m_stride - 1, m_stride, m_stride + 1,
+        },
+        m_states(m_stride * (m_rows + 2), STATE_BORDER),
+        m_frontier_position(m_states.size(), -1),
+        m_safe_position(m_states.size(), -1),
+        m_dirty(m_states.size(), false),
+        m_unknown_count(m_rows * m_columns) {
+        std::vector<GridCoords> revealed;
+
+        for (int y = 0; y < m_rows; y++)
+            for (int x = 0; x < m_columns; x++) {
+                m_states[cell_index(x, y)] = STATE_UNKNOWN;
+
+                if (game.get_grid_cell(x, y).revealed)
+                    revealed.push_back({x, y, true});
+            }
+
+        update(revealed);
+    }
+
+    [[nodiscard]] int get_rows() const {
+        return m_rows;
+    }
+
+    [[nodiscard]] int get_columns() const {
+        return m_columns;
+    }
+
+    [[nodiscard]] CellState get_state(const int x, const int y) const {
+        return m_states[cell_index(x, y)];
+    }
+
+    /**
+     * Hidden cells deduced to be safe, in the order they were found
+     */
+    [[nodiscard]] const std::vector<int> &get_safe_cells() const {
+        return m_safe_cells;
+    }
+
+    [[nodiscard]] const std::vector<int> &get_mine_cells() const {
+        return m_mine_cells;
+    }
+
+    /**
+     * Unknown cells next to a revealed number, in no particular order
+     */
+    [[nodiscard]] const std::vector<int> &get_frontier() const {
+        return m_frontier;
+    }
+
+    /**
+     * Hidden cells not deduced yet, on the frontier or not
+     */
+    [[nodiscard]] int get_unknown_count() const {
+        return m_unknown_count;
+    }
+
+    /**
+     * Mines not deduced yet, wherever they are
+     */
+    [[nodiscard]] int get_unknown_mines() const {
+        return m_game.get_total_mines() - static_cast<int>(m_mine_cells.size());
+    }
+
+    [[nodiscard]] int get_stride() const {
+        return m_stride;
+    }
+
+    [[nodiscard]] const int *get_neighbour_offsets() const {
+        return m_neighbour_offsets;
+    }
+
+    [[nodiscard]] CellState get_state(const int index) const {
+        return m_states[index];
+    }
+
+    [[nodiscard]] GridCoords get_coords(const int index) const {
+        return {index % m_stride - 1, index / m_stride - 1, true};
+    }
+
+    [[nodiscard]] int cell_index(const int x, const int y) const {
+        return (y + 1) * m_stride + x + 1;
+    }
+
+    /**
+     * Applies the cells returned by Game::reveal_cell and deduces everything that follows from them
+     */
+    void update(const std::vector<GridCoords> &revealed) {
+        for (const auto &[x, y, inside] : revealed) {
+            const int index = cell_index(x, y);
+
+            // A revealed mine ends the game, it only counts as a known mine from here on
+            if (m_game.get_grid_cell(x, y).type == Game::CELL_MINE) {
+                set_state(index, STATE_MINE);
+                continue;
+            }
+
+            if (m_states[index] == STATE_UNKNOWN)
+                m_unknown_count--;
+
+            remove_from(m_frontier, m_frontier_position, index);
+            remove_from(m_safe_cells, m_safe_position, index);
+            m_states[index] = STATE_REVEALED;
+            mark_dirty(index);
+
+            for (const int offset : m_neighbour_offsets) {
+                const int neighbour = index + offset;
+
+                if (m_states[neighbour] == STATE_UNKNOWN)
+                    add_to(m_frontier, m_frontier_position, neighbour);
+                else
+                    mark_dirty(neighbour);
+            }
+        }
+
+        propagate();
+    }
+
+    /**
+     * Hidden neighbours of a revealed number that aren't deduced yet, and how many of them are mines
+     */
+    [[nodiscard]] Constraint get_constraint(const int index) const {
+        const GridCoords coords = get_coords(index);
+        Constraint constraint;
+        constraint.mines = m_game.get_grid_cell(coords.x, coords.y).type - Game::CELL_0;
+
+        for (const int offset : m_neighbour_offsets) {
+            const int neighbour = index + offset;
+
+            if (m_states[neighbour] == STATE_MINE)
+                constraint.mines--;
+            else if (m_states[neighbour] == STATE_UNKNOWN)
+                constraint.cells[constraint.size++] = neighbour;
+        }
+
+        return constraint;
+    }
+
+private:
+    static void add_to(std::vector<int> &cells, std::vector<int> &positions, const int index) {
+        if (positions[index] != -1)
+            return;
+
+        positions[index] = static_cast<int>(cells.size());
+        cells.push_back(index);
+    }
+
+    static void remove_from(std::vector<int> &cells, std::vector<int> &positions, const int index) {
+        const int position = positions[index];
+        if (position == -1)
+            return;
+
+        cells[position] = cells.back();
+        positions[cells[position]] = position;
+        cells.pop_back();
+        positions[index] = -1;
+    }
+
+    void mark_dirty(const int index) {
+        if (m_states[index] != STATE_REVEALED || m_dirty[index])
+            return;
+
+        m_dirty[index] = true;
+        m_worklist.push_back(index);
+    }
+
+    void mark_neighbours_dirty(const int index) {
+        for (const int offset : m_neighbour_offsets)
+            mark_dirty(index + offset);
+    }
+
+    void set_state(const int index, const CellState state) {
+        if (m_states[index] != STATE_UNKNOWN)
+            return;
+
+        m_states[index] = state;
+        m_unknown_count--;
+        remove_from(m_frontier, m_frontier_position, index);
+
+        if (state == STATE_MINE)
+            m_mine_cells.push_back(index);
+        else
+            add_to(m_safe_cells, m_safe_position, index);
+
+        mark_neighbours_dirty(index);
+    }
+
+    void propagate() {
+        while (!m_worklist.empty()) {
+            const int index = m_worklist.back();
+            m_worklist.pop_back();
+            m_dirty[index] = false;
+
+            const Constraint constraint = get_constraint(index);
+            if (constraint.size == 0)
+                continue;
+
+            // Single point rule
+            if (constraint.mines == 0 || constraint.mines == constraint.size) {
+                const CellState state = constraint.mines == 0 ? STATE_SAFE : STATE_MINE;
+
+                for (int i = 0; i < constraint.size; i++)
+                    set_state(constraint.cells[i], state);
+
+                continue;
+            }
+
+            apply_subset_rule(index, constraint);
+        }
+    }
+
+    /**
+     * Compares a constraint with every other one that can share cells with it, i.e. all within two cells
+     */
+    void apply_subset_rule(const int index, const Constraint &constraint) {
+        const GridCoords coords = get_coords(index);
+
+        for (int dy = -2; dy <= 2; dy++) {
+            if (coords.y + dy < 0 || coords.y + dy >= m_rows)
+                continue;
+
+            for (int dx = -2; dx <= 2; dx++) {
+                if (coords.x + dx < 0 || coords.x + dx >= m_columns || (dx == 0 && dy == 0))
+                    continue;
+
+                const int other_index = index + dy * m_stride + dx;
+                if (m_states[other_index] != STATE_REVEALED)
+                    continue;
+
+                const Constraint other = get_constraint(other_index);
+                if (other.size == 0)
+                    continue;
+
+                if (apply_pair_rule(constraint, other) || apply_pair_rule(other, constraint)) {
+                    // Our own cells changed, so every comparison has to be redone
+                    mark_dirty(index);
+                    return;
+                }
+            }
+        }
+    }
+
+    /**
+     * If b needs as many more mines than a as it has cells outside of a, all those cells are mines, and all cells
+     * of a outside of b are safe. With a inside b and the same amount of mines, this is the usual subset rule.
+     */
+    bool apply_pair_rule(const Constraint &a, const Constraint &b) {
+        int only_a[8], only_b[8];
+        int only_a_size = 0, only_b_size = 0;
+
+        for (int i = 0; i < a.size; i++)
+            if (!contains(b, a.cells[i]))
+                only_a[only_a_size++] = a.cells[i];
+
+        if (only_a_size == a.size)
+            return false;
+
+        for (int i = 0; i < b.size; i++)
+            if (!contains(a, b.cells[i]))
+                only_b[only_b_size++] = b.cells[i];
+
+        if (b.mines - a.mines != only_b_size || only_a_size + only_b_size == 0)
+            return false;
+
+        for (int i = 0; i < only_b_size; i++)
+            set_state(only_b[i], STATE_MINE);
+
+        for (int i = 0; i < only_a_size; i++)
+            set_state(only_a[i], STATE_SAFE);
+
+        return true;
+    }
+
+    static bool contains(const Constraint &constraint, const int index) {
+        for (int i = 0; i < constraint.size; i++)
+            if (constraint.cells[i] == index)
+                return true;
+
+        return false;
+    }
+};
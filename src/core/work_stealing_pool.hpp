@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed size thread pool where every worker owns a task queue.
+ *
+ * Workers pop their own queue from the back and steal from the front of the others once it's empty, so tasks of
+ * uneven length still keep every core busy. Tasks submitted from inside a worker go to that worker's queue.
+ */
+class WorkStealingPool {
+public:
+    typedef std::function<void()> task_t;
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<task_t> tasks;
+    };
+
+    struct WorkerContext {
+        const WorkStealingPool *pool = nullptr;
+        size_t index = 0;
+    };
+
+    static inline thread_local WorkerContext current_worker{nullptr, 0};
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::mutex m_state_mutex;
+    std::condition_variable m_work_available;
+    std::condition_variable m_all_done;
+    // Tasks sitting in a queue, and tasks submitted but not finished yet
+    long m_queued = 0;
+    long m_pending = 0;
+    size_t m_next_queue = 0;
+    bool m_stopping = false;
+
+public:
+    explicit WorkStealingPool(const unsigned threads = default_threads()) {
+        const unsigned count = std::max(threads, 1u);
+
+        for (unsigned i = 0; i < count; i++)
+            m_queues.push_back(std::make_unique<WorkerQueue>());
+
+        for (unsigned i = 0; i < count; i++)
+            m_workers.emplace_back(&WorkStealingPool::run_worker, this, i);
+    }
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard lock(m_state_mutex);
+            m_stopping = true;
+        }
+
+        m_work_available.notify_all();
+
+        for (std::thread &worker : m_workers)
+            worker.join();
+    }
+
+    [[nodiscard]] size_t get_threads() const {
+        return m_workers.size();
+    }
+
+    static unsigned default_threads() {
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    void submit(task_t task) {
+        size_t queue_index;
+
+        // Counted before the task is visible, so it can't finish before being counted as pending
+        {
+            std::lock_guard lock(m_state_mutex);
+            queue_index = current_worker.pool == this ? current_worker.index : m_next_queue++ % m_queues.size();
+            m_queued++;
+            m_pending++;
+        }
+
+        {
+            WorkerQueue &queue = *m_queues[queue_index];
+            std::lock_guard lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+
+        m_work_available.notify_one();
+    }
+
+    /**
+     * Blocks until every submitted task has finished, must not be called from a worker
+     */
+    void wait() {
+        std::unique_lock lock(m_state_mutex);
+        m_all_done.wait(lock, [this] { return m_pending == 0; });
+    }
+
+private:
+    bool pop_task(const size_t index, task_t &task) {
+        const size_t count = m_queues.size();
+
+        for (size_t i = 0; i < count; i++) {
+            WorkerQueue &queue = *m_queues[(index + i) % count];
+            std::lock_guard lock(queue.mutex);
+
+            if (queue.tasks.empty())
+                continue;
+
+            if (i == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void run_worker(const size_t index) {
+        current_worker = {this, index};
+
+        while (true) {
+            task_t task;
+
+            if (!pop_task(index, task)) {
+                std::unique_lock lock(m_state_mutex);
+                m_work_available.wait(lock, [this] { return m_stopping || m_queued > 0; });
+
+                if (m_stopping && m_queued == 0)
+                    return;
+
+                continue;
+            }
+
+            {
+                std::lock_guard lock(m_state_mutex);
+                m_queued--;
+            }
+
+            task();
+
+            std::lock_guard lock(m_state_mutex);
+            if (--m_pending == 0)
+                m_all_done.notify_all();
+        }
+    }
+};
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <functional>
 #include <memory>
 #include <SDL.h>
-#include <thread>
 
+#include "frame_scheduler.hpp"
+#include "latency_tracker.hpp"
+#include "resource_cache.hpp"
+#include "graphics/asset_loader.hpp"
 #include "graphics/color.hpp"
 #include "graphics/font.hpp"
+#include "graphics/text_label.hpp"
 #include "screens/screen.hpp"
 
 struct EngineParameters {
@@ -16,35 +23,86 @@ struct EngineParameters {
 };
 
 class Engine {
+    static constexpr SDL_Keycode LATENCY_OVERLAY_KEY = SDLK_F3;
+    // The overlay text is only updated this often, so it stays readable
+    static constexpr std::chrono::milliseconds LATENCY_OVERLAY_UPDATE_INTERVAL{250};
+    static constexpr std::chrono::milliseconds ASSET_POLL_INTERVAL{10};
+
     std::unique_ptr<Screen> m_screen{};
-    std::chrono::microseconds m_render_interval_microsecs;
+    // Made once the assets it requested are loaded, until then the current screen stays up without input
+    std::function<std::unique_ptr<Screen>()> m_pending_screen{};
+    // Texture managers kept across screens
+    ResourceCache m_resource_cache;
+    FrameScheduler m_frame_scheduler;
+    LatencyTracker m_latency_tracker;
     SDL_Window *m_window;
     SDL_Renderer *m_renderer;
     int m_window_width = 0;
     int m_window_height = 0;
     SDL_Color m_background_color{};
+    // Frames are only rendered after an event, or when a screen asks for one
+    bool m_redraw_requested = true;
+    std::chrono::steady_clock::time_point m_next_redraw = std::chrono::steady_clock::time_point::max();
+    bool m_show_latency_overlay = false;
+    std::unique_ptr<TextLabel> m_latency_overlay_text{};
+    uint64_t m_latency_overlay_frames = 0;
+    std::chrono::steady_clock::time_point m_latency_overlay_updated{};
 
     SDL_Cursor *const m_arrow_cursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_ARROW);
 
 public:
     explicit Engine(const EngineParameters &parameters)
-        : m_render_interval_microsecs(100000 / parameters.screen_refresh_rate),
+        // Some displays don't report their refresh rate
+        : m_frame_scheduler(parameters.screen_refresh_rate > 0 ? parameters.screen_refresh_rate : 60),
           m_window(parameters.window),
           m_renderer(parameters.renderer) {
         SDL_GetWindowSize(m_window, &m_window_width, &m_window_height);
 
         Color::make(m_window);
-        Font::make_shared(m_window_height);
+        AssetLoader::start();
+        Font::request_assets();
 
         m_background_color = Color::get(Color::BACKGROUND).get_rgb();
     }
 
     ~Engine() = default;
 
+    /**
+     * The screen is made once the assets it requests with ScreenT::request_assets(args...) are loaded, so it doesn't
+     * wait on the disk
+     */
     template <class ScreenT, typename... Args>
     void set_screen(Args... args) {
-        m_screen = std::make_unique<ScreenT>(args...);
-        SDL_SetCursor(m_arrow_cursor);
+        ScreenT::request_assets(args...);
+        m_pending_screen = [args...] {
+            return std::make_unique<ScreenT>(args...);
+        };
+        request_redraw();
+    }
+
+    /**
+     * Renders a new frame once the pending events are handled
+     */
+    void request_redraw() {
+        m_redraw_requested = true;
+    }
+
+    /**
+     * Renders a new frame after delay at the latest, for changes that don't come from an event, like timers or
+     * background work
+     */
+    void request_redraw(const std::chrono::milliseconds delay) {
+        m_next_redraw = std::min(m_next_redraw, std::chrono::steady_clock::now() + delay);
+    }
+
+    /**
+     * Renders a new frame once time(nullptr) gets to the next second, for clocks counting in seconds
+     */
+    void request_redraw_next_second() {
+        using namespace std::chrono;
+
+        const milliseconds into_second = duration_cast<milliseconds>(system_clock::now().time_since_epoch()) % 1000;
+        request_redraw(seconds(1) - into_second + milliseconds(1));
     }
 
     [[nodiscard]] SDL_Window *get_window() const {
@@ -55,6 +113,26 @@ public:
         return m_renderer;
     }
 
+    [[nodiscard]] ResourceCache &get_resource_cache() {
+        return m_resource_cache;
+    }
+
+    [[nodiscard]] FrameScheduler::Stats get_frame_stats() const {
+        return m_frame_scheduler.get_stats();
+    }
+
+    [[nodiscard]] const LatencyTracker &get_latency_tracker() const {
+        return m_latency_tracker;
+    }
+
+    /**
+     * FrameScheduler::UNCAPPED also turns vsync off, for benchmarks
+     */
+    void set_target_fps(const int target_fps) {
+        m_frame_scheduler.set_target_fps(target_fps);
+        SDL_RenderSetVSync(m_renderer, m_frame_scheduler.get_target_fps() != FrameScheduler::UNCAPPED);
+    }
+
     [[nodiscard]] int get_window_width() const {
         return m_window_width;
     }
@@ -63,53 +141,208 @@ public:
         return m_window_height;
     }
 
+    /**
+     * Sleeps until there's an event or a frame is due, so idle screens use no CPU or GPU time
+     */
     void run() {
         SDL_Event event;
 
         while (true) {
-            while (SDL_PollEvent(&event) != 0) {
-                m_screen->before_event(event);
-
-                switch (event.type) {
-                    case SDL_QUIT:
-                        m_screen->on_quit_event(event.quit);
-                        goto exit_game_loop;
-
-                    case SDL_KEYDOWN:
-                    case SDL_KEYUP:
-                        m_screen->on_keyboard_event(event.key);
-                        break;
-
-                    case SDL_MOUSEBUTTONDOWN:
-                    case SDL_MOUSEBUTTONUP:
-                        m_screen->on_mouse_button_event(event.button);
-                        break;
-
-                    case SDL_MOUSEMOTION:
-                        m_screen->on_mouse_motion_event(event.motion);
-                        break;
-
-                    case SDL_MOUSEWHEEL:
-                        m_screen->on_mouse_wheel_event(event.wheel);
-                        break;
-
-                    default:
-                        break;
-                }
+            if (SDL_WaitEventTimeout(&event, get_wait_timeout()) != 0) {
+                do {
+                    const LatencyTracker::clock::time_point polled = LatencyTracker::clock::now();
+                    // The screen being left may have saved its state already
+                    const bool accepts_input = m_screen != nullptr && m_pending_screen == nullptr;
+
+                    // Cached textures drawn as render targets lost their contents
+                    if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+                        m_resource_cache.clear();
+
+                    if (m_screen != nullptr)
+                        m_screen->before_event(event);
+
+                    switch (event.type) {
+                        case SDL_QUIT:
+                            // The pending screen may hold state only it saves, like a game loaded from its save
+                            show_pending_screen(true);
+
+                            if (m_screen != nullptr)
+                                m_screen->on_quit_event(event.quit);
+
+                            goto exit_game_loop;
+
+                        case SDL_KEYDOWN:
+                        case SDL_KEYUP:
+                            if (event.type == SDL_KEYDOWN && event.key.keysym.sym == LATENCY_OVERLAY_KEY)
+                                m_show_latency_overlay = !m_show_latency_overlay;
+
+                            if (accepts_input)
+                                m_screen->on_keyboard_event(event.key);
+
+                            m_latency_tracker.input_handled(polled);
+                            break;
+
+                        case SDL_MOUSEBUTTONDOWN:
+                        case SDL_MOUSEBUTTONUP:
+                            if (accepts_input)
+                                m_screen->on_mouse_button_event(event.button);
+
+                            m_latency_tracker.input_handled(polled);
+                            break;
+
+                        case SDL_MOUSEMOTION:
+                            if (accepts_input)
+                                m_screen->on_mouse_motion_event(event.motion);
+
+                            m_latency_tracker.input_handled(polled);
+                            break;
+
+                        case SDL_MOUSEWHEEL:
+                            if (accepts_input)
+                                m_screen->on_mouse_wheel_event(event.wheel);
+
+                            m_latency_tracker.input_handled(polled);
+                            break;
+
+                        default:
+                            break;
+                    }
+                } while (SDL_PollEvent(&event) != 0);
+
+                // Any event can change what's on screen, including window ones like being uncovered
+                m_redraw_requested = true;
             }
 
+            show_pending_screen();
+
+            if (!m_redraw_requested && std::chrono::steady_clock::now() < m_next_redraw)
+                continue;
+
+            // Reset before rendering, so the screen can ask for the next frame from render()
+            m_redraw_requested = false;
+            m_next_redraw = std::chrono::steady_clock::time_point::max();
+
+            m_frame_scheduler.begin_frame();
+
             const auto [r, g, b, a] = m_background_color;
             SDL_SetRenderDrawColor(m_renderer, r, g, b, a);
 
+            const LatencyTracker::clock::time_point render_start = LatencyTracker::clock::now();
+
             SDL_RenderClear(m_renderer);
-            m_screen->render();
+
+            // Only the background until the first screen is ready
+            if (m_screen != nullptr)
+                m_screen->render();
+
+            if (m_screen != nullptr && m_show_latency_overlay)
+                render_latency_overlay();
+
+            const LatencyTracker::clock::time_point present_start = LatencyTracker::clock::now();
+
             SDL_RenderPresent(m_renderer);
 
-            std::this_thread::sleep_for(m_render_interval_microsecs);
+            m_latency_tracker.frame_presented(render_start, present_start);
+            m_frame_scheduler.end_frame();
         }
 
     exit_game_loop:
+        m_pending_screen = nullptr;
         m_screen = nullptr;
+        m_resource_cache.clear();
+        m_latency_overlay_text = nullptr;
         Font::free_shared();
+        AssetLoader::stop();
+    }
+
+private:
+    /**
+     * Swaps in the pending screen once the AssetLoader is done, or right away waiting for the assets if forced
+     */
+    void show_pending_screen(const bool force = false) {
+        if (m_pending_screen == nullptr || (!force && !AssetLoader::is_idle()))
+            return;
+
+        // Made here the first time, once their files are read
+        if (Font::get_shared(Font::PRIMARY) == nullptr)
+            Font::make_shared(m_window_height);
+
+        m_screen = m_pending_screen();
+        m_pending_screen = nullptr;
+
+        // The previous screen's resources may be unused now
+        m_resource_cache.trim();
+        SDL_SetCursor(m_arrow_cursor);
+        request_redraw();
+    }
+
+    /**
+     * Input latency percentiles in the bottom left corner, toggled with LATENCY_OVERLAY_KEY
+     */
+    void render_latency_overlay() {
+        const auto now = std::chrono::steady_clock::now();
+        const uint64_t frames = m_latency_tracker.get_frame_count();
+        const bool outdated = m_latency_overlay_text == nullptr || m_latency_overlay_frames != frames;
+
+        if (outdated && now - m_latency_overlay_updated < LATENCY_OVERLAY_UPDATE_INTERVAL) {
+            request_redraw(std::chrono::ceil<std::chrono::milliseconds>(
+                m_latency_overlay_updated + LATENCY_OVERLAY_UPDATE_INTERVAL - now
+            ));
+        } else if (outdated) {
+            const auto [count, p50, p95, p99] = m_latency_tracker.get_percentiles();
+            char text[128];
+            snprintf(
+                text,
+                sizeof text,
+                "Input latency p50 %.1f ms, p95 %.1f ms, p99 %.1f ms (%llu frames)",
+                p50,
+                p95,
+                p99,
+                static_cast<unsigned long long>(count)
+            );
+
+            if (m_latency_overlay_text == nullptr)
+                m_latency_overlay_text = std::make_unique<TextLabel>(
+                    m_renderer,
+                    *Font::get_shared(Font::SECONDARY),
+                    text,
+                    Color::LIGHTER_GREY
+                );
+            else
+                m_latency_overlay_text->update_text(text);
+
+            const int padding = static_cast<int>(m_window_height * 0.025);
+            m_latency_overlay_text->set_position(
+                padding,
+                m_window_height - m_latency_overlay_text->get_h() - padding
+            );
+
+            m_latency_overlay_frames = frames;
+            m_latency_overlay_updated = now;
+        }
+
+        m_latency_overlay_text->render();
+    }
+
+    /**
+     * Milliseconds until the next frame is due, or -1 to wait for an event
+     */
+    [[nodiscard]] int get_wait_timeout() const {
+        using namespace std::chrono;
+
+        if (m_redraw_requested)
+            return 0;
+
+        // Polls the AssetLoader while a screen waits for it
+        const milliseconds::rep poll_timeout = m_pending_screen != nullptr ? ASSET_POLL_INTERVAL.count() : -1;
+
+        if (m_next_redraw == steady_clock::time_point::max())
+            return static_cast<int>(poll_timeout);
+
+        // Rounded up, so it doesn't wake up just before the frame is due
+        const auto wait = ceil<milliseconds>(m_next_redraw - steady_clock::now());
+        const milliseconds::rep timeout = std::max(wait.count(), milliseconds::rep(0));
+
+        return static_cast<int>(poll_timeout < 0 ? timeout : std::min(timeout, poll_timeout));
     }
 };
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * Paces frames to a target rate, timing each one with a monotonic clock.
+ *
+ * end_frame() only sleeps for what's left of the frame budget after the frame itself, so slow frames aren't delayed
+ * any further, and with vsync the wait inside SDL_RenderPresent already counts towards the budget.
+ */
+class FrameScheduler {
+public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr int UNCAPPED = 0;
+    // Latest frames the statistics are taken from
+    static constexpr size_t STATS_FRAMES = 240;
+
+    /**
+     * Times in milliseconds, from begin_frame() to end_frame()
+     */
+    struct Stats {
+        uint64_t frames;
+        double average;
+        double p50;
+        double p95;
+        double max;
+    };
+
+private:
+    int m_target_fps = UNCAPPED;
+    clock::duration m_budget = clock::duration::zero();
+    clock::time_point m_frame_start{};
+    std::vector<clock::duration> m_frame_times{};
+    uint64_t m_frames = 0;
+
+public:
+    explicit FrameScheduler(const int target_fps) {
+        m_frame_times.reserve(STATS_FRAMES);
+        set_target_fps(target_fps);
+    }
+
+    [[nodiscard]] int get_target_fps() const {
+        return m_target_fps;
+    }
+
+    /**
+     * UNCAPPED to never sleep
+     */
+    void set_target_fps(const int target_fps) {
+        m_target_fps = std::max(target_fps, UNCAPPED);
+        m_budget = m_target_fps == UNCAPPED
+                ? clock::duration::zero()
+                : std::chrono::duration_cast<clock::duration>(std::chrono::seconds(1)) / m_target_fps;
+    }
+
+    void begin_frame() {
+        m_frame_start = clock::now();
+    }
+
+    /**
+     * Records the frame and sleeps until its budget is used up
+     */
+    void end_frame() {
+        const clock::duration frame_time = clock::now() - m_frame_start;
+
+        if (m_frame_times.size() < STATS_FRAMES)
+            m_frame_times.push_back(frame_time);
+        else
+            m_frame_times[m_frames % STATS_FRAMES] = frame_time;
+
+        m_frames++;
+
+        if (frame_time < m_budget)
+            std::this_thread::sleep_until(m_frame_start + m_budget);
+    }
+
+    [[nodiscard]] Stats get_stats() const {
+        if (m_frame_times.empty())
+            return {0, 0, 0, 0, 0};
+
+        std::vector<clock::duration> sorted = m_frame_times;
+        std::sort(sorted.begin(), sorted.end());
+
+        clock::duration total = clock::duration::zero();
+        for (const clock::duration frame_time : sorted)
+            total += frame_time;
+
+        return {
+            m_frames,
+            to_milliseconds(total) / static_cast<double>(sorted.size()),
+            to_milliseconds(sorted[(sorted.size() - 1) / 2]),
+            to_milliseconds(sorted[(sorted.size() - 1) * 95 / 100]),
+            to_milliseconds(sorted.back()),
+        };
+    }
+
+private:
+    static double to_milliseconds(const clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+};
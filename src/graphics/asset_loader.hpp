@@ -0,0 +1,213 @@
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL2_rotozoom.h>
+#include <string>
+#include <vector>
+
+#include "../core/work_stealing_pool.hpp"
+
+/**
+ * Decodes and scales images and reads files on worker threads, so screens don't wait on the disk.
+ *
+ * Screens request what they'll use before they're made, see Engine::set_screen(), and the Texture and Font
+ * constructors take the results on the main thread, where they're uploaded. Assets that weren't requested are loaded
+ * on the spot. Results are kept until stop(), so requesting them again is free.
+ *
+ * Only meant to be called from the main thread.
+ */
+class AssetLoader {
+public:
+    using Surface = std::shared_ptr<SDL_Surface>;
+    using File = std::shared_ptr<const std::vector<char>>;
+
+private:
+    /**
+     * Image as decoded, shared by its scaled versions. Whichever task needs it first decodes it.
+     */
+    struct Decoded {
+        std::once_flag once;
+        Surface surface;
+    };
+
+    static std::unique_ptr<WorkStealingPool> pool;
+    static std::map<std::string, std::shared_ptr<Decoded>> decoded_images;
+    static std::map<std::string, std::shared_future<Surface>> images;
+    static std::map<std::string, std::shared_future<File>> files;
+
+public:
+    static void start(const unsigned threads = WorkStealingPool::default_threads()) {
+        pool = std::make_unique<WorkStealingPool>(threads);
+    }
+
+    /**
+     * Waits for the loads in flight and frees every result
+     */
+    static void stop() {
+        pool = nullptr;
+        images.clear();
+        decoded_images.clear();
+        files.clear();
+    }
+
+    /**
+     * Zero sized is as decoded, zero width keeps the aspect ratio at the given height
+     */
+    static void request_image(const char *path, const SDL_Point size = {0, 0}) {
+        const std::string key = get_image_key(path, size);
+
+        if (images.count(key) != 0)
+            return;
+
+        const std::shared_ptr<Decoded> decoded = get_decoded(path);
+        const std::string image_path = path;
+
+        images[key] = submit<Surface>([decoded, image_path, size] {
+            return load_image(*decoded, image_path.c_str(), size);
+        });
+    }
+
+    static void request_file(const char *path) {
+        if (files.count(path) != 0)
+            return;
+
+        const std::string file_path = path;
+
+        files[path] = submit<File>([file_path] {
+            return load_file(file_path.c_str());
+        });
+    }
+
+    /**
+     * Whether every requested asset is loaded
+     */
+    [[nodiscard]] static bool is_idle() {
+        for (const auto &[key, image] : images)
+            if (!is_ready(image))
+                return false;
+
+        for (const auto &[path, file] : files)
+            if (!is_ready(file))
+                return false;
+
+        return true;
+    }
+
+    /**
+     * New surface owned by the caller, see request_image() for the size. It isn't resampled when that wouldn't look
+     * better than scaling it on render, see scale_surface().
+     */
+    [[nodiscard]] static SDL_Surface *get_image(const char *path, const SDL_Point size = {0, 0}) {
+        const auto found = images.find(get_image_key(path, size));
+
+        const Surface image = found != images.end()
+                ? found->second.get()
+                : load_image(*get_decoded(path), path, size);
+
+        return image != nullptr ? SDL_DuplicateSurface(image.get()) : nullptr;
+    }
+
+    [[nodiscard]] static File get_file(const char *path) {
+        const auto found = files.find(path);
+        return found != files.end() ? found->second.get() : load_file(path);
+    }
+
+    /**
+     * New surface with the zoom applied, or null if it's better scaled on render: SDL2_gfx only shrinks by whole
+     * factors
+     */
+    [[nodiscard]] static SDL_Surface *scale_surface(SDL_Surface *surface, const double zoom_x, const double zoom_y) {
+        if (zoom_x == 1 && zoom_y == 1)
+            return nullptr;
+
+        if (zoom_x < 1 && zoom_y < 1) {
+            const double factor_x = 1 / zoom_x;
+            const double factor_y = 1 / zoom_y;
+            const int factor_x_int = factor_x;
+            const int factor_y_int = factor_y;
+
+            if (factor_x != factor_x_int || factor_x_int != factor_y_int)
+                return nullptr;
+
+            return shrinkSurface(surface, factor_x_int, factor_y_int);
+        }
+
+        return zoomSurface(surface, zoom_x, zoom_x, SMOOTHING_ON);
+    }
+
+private:
+    template<typename T, typename Load>
+    static std::shared_future<T> submit(Load load) {
+        const auto promise = std::make_shared<std::promise<T>>();
+        std::shared_future<T> future = promise->get_future().share();
+
+        if (pool == nullptr)
+            promise->set_value(load());
+        else
+            pool->submit([promise, load] {
+                promise->set_value(load());
+            });
+
+        return future;
+    }
+
+    template<typename T>
+    static bool is_ready(const std::shared_future<T> &future) {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    static std::string get_image_key(const char *path, const SDL_Point size) {
+        return std::string(path) + '@' + std::to_string(size.x) + 'x' + std::to_string(size.y);
+    }
+
+    static std::shared_ptr<Decoded> get_decoded(const char *path) {
+        std::shared_ptr<Decoded> &decoded = decoded_images[path];
+
+        if (decoded == nullptr)
+            decoded = std::make_shared<Decoded>();
+
+        return decoded;
+    }
+
+    static Surface load_image(Decoded &decoded, const char *path, const SDL_Point size) {
+        std::call_once(decoded.once, [&decoded, path] {
+            decoded.surface = Surface(IMG_Load(path), SDL_FreeSurface);
+        });
+
+        const Surface &surface = decoded.surface;
+
+        if (surface == nullptr || (size.x == 0 && size.y == 0))
+            return surface;
+
+        const double zoom_y = static_cast<double>(size.y) / surface->h;
+        const double zoom_x = size.x == 0 ? zoom_y : static_cast<double>(size.x) / surface->w;
+        SDL_Surface *scaled = scale_surface(surface.get(), zoom_x, zoom_y);
+
+        return scaled != nullptr ? Surface(scaled, SDL_FreeSurface) : surface;
+    }
+
+    static File load_file(const char *path) {
+        std::ifstream file(path, std::ios::binary | std::ios::in);
+
+        if (!file)
+            return nullptr;
+
+        return std::make_shared<const std::vector<char>>(
+            std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>()
+        );
+    }
+};
+
+std::unique_ptr<WorkStealingPool> AssetLoader::pool = nullptr;
+std::map<std::string, std::shared_ptr<AssetLoader::Decoded>> AssetLoader::decoded_images{};
+std::map<std::string, std::shared_future<AssetLoader::Surface>> AssetLoader::images{};
+std::map<std::string, std::shared_future<AssetLoader::File>> AssetLoader::files{};
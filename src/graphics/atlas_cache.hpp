@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <SDL.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "mapped_file.hpp"
+#include "texture.hpp"
+
+/**
+ * Atlases saved to disk, so later launches upload them in one go instead of drawing them sprite by sprite.
+ *
+ * Each file holds a header, the caller's metadata (e.g. where each sprite is) and the ARGB8888 pixels. Files are named
+ * after a Key hashing every input the atlas is drawn from, so changing any of them just misses the cache.
+ */
+class AtlasCache {
+public:
+    /**
+     * 64-bit FNV-1a hash of everything an atlas depends on
+     */
+    class Key {
+        static constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+        static constexpr uint64_t FNV_PRIME = 0x100000001b3;
+
+        uint64_t m_hash = FNV_OFFSET_BASIS;
+
+    public:
+        [[nodiscard]] uint64_t get() const {
+            return m_hash;
+        }
+
+        Key &add(const void *data, const size_t size) {
+            const auto *bytes = static_cast<const unsigned char *>(data);
+
+            for (size_t i = 0; i < size; i++) {
+                m_hash ^= bytes[i];
+                m_hash *= FNV_PRIME;
+            }
+
+            return *this;
+        }
+
+        template<typename T>
+        Key &add(const T &value) {
+            static_assert(std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>, "Hash the pointed data instead");
+            return add(&value, sizeof(value));
+        }
+
+        /**
+         * Null-terminated, null itself hashes as an empty string
+         */
+        Key &add_string(const char *string) {
+            return add(string != nullptr ? string : "", string != nullptr ? std::strlen(string) + 1 : 1);
+        }
+
+        /**
+         * Size and last write time, cheaper than the contents and enough to notice an asset was replaced
+         */
+        Key &add_file(const char *path) {
+            std::error_code error;
+            const uintmax_t size = std::filesystem::file_size(path, error);
+            const auto write_time = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+
+            add_string(path);
+            add(size);
+            return add(write_time);
+        }
+    };
+
+private:
+    static constexpr uint32_t FILE_MAGIC = 0x4341534d; // "MSAC"
+    static constexpr uint32_t FILE_VERSION = 1;
+    static constexpr auto CACHE_DIR_PATH = "cache/";
+    static constexpr int BYTES_PER_PIXEL = 4;
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t key;
+        uint32_t metadata_size;
+        uint32_t pixel_format;
+        int32_t width;
+        int32_t height;
+    };
+
+public:
+    /**
+     * Whether there's a cache file for the key, without checking it
+     */
+    [[nodiscard]] static bool contains(const Key &key) {
+        std::error_code error;
+        return std::filesystem::exists(get_path(key), error);
+    }
+
+    /**
+     * Null if there's no valid cache for the key, otherwise metadata is filled in with the saved one
+     */
+    [[nodiscard]] static std::shared_ptr<Texture> load(
+        SDL_Renderer *renderer,
+        const Key &key,
+        void *metadata,
+        const size_t metadata_size
+    ) {
+        const MappedFile file(get_path(key).c_str());
+
+        if (!file.is_open() || file.get_size() < sizeof(Header))
+            return nullptr;
+
+        Header header;
+        std::memcpy(&header, file.get_data(), sizeof(header));
+
+        if (header.magic != FILE_MAGIC
+            || header.version != FILE_VERSION
+            || header.key != key.get()
+            || header.metadata_size != metadata_size
+            || header.pixel_format != SDL_PIXELFORMAT_ARGB8888
+            || header.width <= 0
+            || header.height <= 0)
+            return nullptr;
+
+        const size_t pixels_offset = get_pixels_offset(metadata_size);
+        const size_t pitch = static_cast<size_t>(header.width) * BYTES_PER_PIXEL;
+
+        // Also catches files cut short
+        if (file.get_size() != pixels_offset + pitch * header.height)
+            return nullptr;
+
+        std::memcpy(metadata, file.get_data() + sizeof(Header), metadata_size);
+
+        return std::make_shared<Texture>(
+            renderer,
+            SDL_Rect{0, 0, header.width, header.height},
+            file.get_data() + pixels_offset,
+            static_cast<int>(pitch)
+        );
+    }
+
+    /**
+     * Reads the atlas back from the renderer, it must be a render target texture
+     */
+    static void save(
+        SDL_Renderer *renderer,
+        const Key &key,
+        const void *metadata,
+        const size_t metadata_size,
+        const Texture &atlas
+    ) {
+        const int pitch = atlas.get_w() * BYTES_PER_PIXEL;
+        std::vector<unsigned char> pixels(static_cast<size_t>(pitch) * atlas.get_h());
+
+        const Texture::ScopedRender scoped_render = atlas.set_as_render_target();
+
+        if (SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_ARGB8888, pixels.data(), pitch) != 0)
+            return;
+
+        scoped_render.release();
+
+        std::error_code error;
+        std::filesystem::create_directory(CACHE_DIR_PATH, error);
+
+        const std::string path = get_path(key);
+        // Written aside and renamed, so a crash mid-write never leaves a file that looks valid
+        const std::string temporary_path = path + ".tmp";
+        const Header header = {
+            FILE_MAGIC,
+            FILE_VERSION,
+            key.get(),
+            static_cast<uint32_t>(metadata_size),
+            SDL_PIXELFORMAT_ARGB8888,
+            atlas.get_w(),
+            atlas.get_h(),
+        };
+        const size_t padding = get_pixels_offset(metadata_size) - sizeof(Header) - metadata_size;
+        constexpr char zeros[BYTES_PER_PIXEL] = {};
+
+        std::ofstream cache_file(temporary_path, std::ios::binary | std::ios::out);
+
+        cache_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        cache_file.write(static_cast<const char *>(metadata), static_cast<std::streamsize>(metadata_size));
+        cache_file.write(zeros, static_cast<std::streamsize>(padding));
+        cache_file.write(reinterpret_cast<const char *>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+        cache_file.close();
+
+        if (!cache_file) {
+            std::filesystem::remove(temporary_path, error);
+            return;
+        }
+
+        std::filesystem::rename(temporary_path, path, error);
+    }
+
+private:
+    static std::string get_path(const Key &key) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "atlas_%016llx.bin", static_cast<unsigned long long>(key.get()));
+        return std::string(CACHE_DIR_PATH) + name;
+    }
+
+    /**
+     * Pixels start aligned to a whole pixel
+     */
+    static size_t get_pixels_offset(const size_t metadata_size) {
+        const size_t offset = sizeof(Header) + metadata_size;
+        return (offset + BYTES_PER_PIXEL - 1) / BYTES_PER_PIXEL * BYTES_PER_PIXEL;
+    }
+};
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "grid_layout.hpp"
+#include "../core/game.hpp"
+
+/**
+ * Pan and zoom of a grid on top of its GridLayout.
+ *
+ * Converts between cells and window pixels and gives the range of cells in view, so drawing and hit-testing never
+ * touch a cell outside of the window, whatever the size of the board.
+ */
+class Camera {
+public:
+    /**
+     * Cells in view, inclusive. Empty if first > last.
+     */
+    struct Range {
+        int first_x;
+        int first_y;
+        int last_x;
+        int last_y;
+    };
+
+    static constexpr double MAX_ZOOM = 4;
+    static constexpr double ZOOM_STEP = 1.15;
+    // Smallest cells zooming out can reach, so the cells in view stay bounded by the window size
+    static constexpr double MIN_CELL_PIXELS = 4;
+
+private:
+    const int m_rows;
+    const int m_columns;
+    const int m_window_width;
+    const int m_window_height;
+    const GridLayout::Measurements m_measurements;
+    // 1 if the layout fits the board, else the zoom that does, down to MIN_CELL_PIXELS
+    const double m_min_zoom;
+    double m_zoom = 1;
+    // Window pixel of the top left corner of the grid
+    double m_x = 0;
+    double m_y = 0;
+
+public:
+    Camera(
+        const int rows,
+        const int columns,
+        const GridLayout::Measurements &measurements,
+        const int window_width,
+        const int window_height
+    ) : m_rows(rows),
+        m_columns(columns),
+        m_window_width(window_width),
+        m_window_height(window_height),
+        m_measurements(measurements),
+        m_min_zoom(calculate_min_zoom(rows, columns, measurements.cell_size, window_width, window_height)) {
+        reset();
+    }
+
+    [[nodiscard]] double get_zoom() const {
+        return m_zoom;
+    }
+
+    /**
+     * Window pixel where column i starts
+     */
+    [[nodiscard]] int get_cell_x(const int i) const {
+        return static_cast<int>(std::floor(m_x + i * get_cell_size()));
+    }
+
+    /**
+     * Window pixel where row j starts
+     */
+    [[nodiscard]] int get_cell_y(const int j) const {
+        return static_cast<int>(std::floor(m_y + j * get_cell_size()));
+    }
+
+    [[nodiscard]] Range get_visible_range() const {
+        const double cell_size = get_cell_size();
+
+        return {
+            std::max(static_cast<int>(std::floor(-m_x / cell_size)), 0),
+            std::max(static_cast<int>(std::floor(-m_y / cell_size)), 0),
+            std::min(static_cast<int>(std::floor((m_window_width - m_x) / cell_size)), m_columns - 1),
+            std::min(static_cast<int>(std::floor((m_window_height - m_y) / cell_size)), m_rows - 1),
+        };
+    }
+
+    [[nodiscard]] Game::GridCoords calculate_grid_cell(const int click_x, const int click_y) const {
+        const double x = std::floor((click_x - m_x) / get_cell_size());
+        const double y = std::floor((click_y - m_y) / get_cell_size());
+
+        if (x < 0 || x >= m_columns || y < 0 || y >= m_rows)
+            return {-1, -1, false};
+
+        return {static_cast<int>(x), static_cast<int>(y), true};
+    }
+
+    void pan(const double dx, const double dy) {
+        m_x += dx;
+        m_y += dy;
+        clamp();
+    }
+
+    /**
+     * Zooms in (positive steps) or out, keeping the board point under the anchor in place
+     */
+    void zoom_at(const int anchor_x, const int anchor_y, const double steps) {
+        const double zoom = std::clamp(m_zoom * std::pow(ZOOM_STEP, steps), m_min_zoom, MAX_ZOOM);
+        const double factor = zoom / m_zoom;
+
+        m_x = anchor_x - (anchor_x - m_x) * factor;
+        m_y = anchor_y - (anchor_y - m_y) * factor;
+        m_zoom = zoom;
+        clamp();
+    }
+
+    /**
+     * Back to the GridLayout position, or as much of the board as fits if it's bigger than the window
+     */
+    void reset() {
+        m_zoom = m_min_zoom;
+
+        const double cell_size = get_cell_size();
+        m_x = (m_window_width - m_columns * cell_size) / 2;
+        m_y = m_measurements.grid_y_offset + (m_measurements.grid_height - m_rows * cell_size) / 2;
+    }
+
+private:
+    /**
+     * Only boards overflowing the window zoom out, a layout rounding its cell size up must still start at 1
+     */
+    static double calculate_min_zoom(
+        const int rows,
+        const int columns,
+        const int cell_size,
+        const int window_width,
+        const int window_height
+    ) {
+        if (columns * cell_size <= window_width && rows * cell_size <= window_height)
+            return 1;
+
+        const double fitting_cell_size = std::max(
+            std::min(
+                window_width * GridLayout::WINDOW_FILL / columns,
+                window_height * GridLayout::WINDOW_FILL / rows
+            ),
+            MIN_CELL_PIXELS
+        );
+
+        return std::min(1.0, fitting_cell_size / cell_size);
+    }
+
+    [[nodiscard]] double get_cell_size() const {
+        return m_measurements.cell_size * m_zoom;
+    }
+
+    /**
+     * The board always covers the center of the window
+     */
+    void clamp() {
+        const double cell_size = get_cell_size();
+        const double center_x = m_window_width / 2.0;
+        const double center_y = m_window_height / 2.0;
+
+        m_x = std::clamp(m_x, std::min(center_x - m_columns * cell_size, center_x), center_x);
+        m_y = std::clamp(m_y, std::min(center_y - m_rows * cell_size, center_y), center_y);
+    }
+};
@@ -5,6 +5,9 @@
 #include <memory>
 #include <SDL_ttf.h>
 
+#include "asset_loader.hpp"
+#include "glyph_atlas.hpp"
+
 class Font {
 public:
     enum Type {
@@ -32,18 +35,26 @@ private:
         "assets/fonts/Rubik-Bold.ttf",
     };
 
+    // Relative to the window height
+    static constexpr double SHARED_SIZE_FACTORS[NAMES] = {0.025, 0.02};
+
     static Shared shared_fonts[NAMES];
 
+    // Font file read by the AssetLoader, TTF_Font reads it as long as it's open
+    AssetLoader::File m_data{};
     TTF_Font *m_raw = nullptr;
     int m_size = 0;
+    std::unique_ptr<GlyphAtlas> m_glyph_atlas{};
 
 public:
     Font() = default;
 
-    Font(const Type type, const int size) : m_size(size) {
-        m_raw = TTF_OpenFont(FONT_PATHS[type], m_size);
+    Font(const Type type, const int size) : m_data(AssetLoader::get_file(FONT_PATHS[type])), m_size(size) {
+        if (m_data != nullptr)
+            m_raw = TTF_OpenFontRW(SDL_RWFromConstMem(m_data->data(), static_cast<int>(m_data->size())), 1, m_size);
+
         if (m_raw == nullptr) {
-            std::cerr << "Error while loading font ID " << type << " at TTF_OpenFont(): " << SDL_GetError()
+            std::cerr << "Error while loading font ID " << type << " at TTF_OpenFontRW(): " << SDL_GetError()
                     << std::endl;
             exit(1);
         }
@@ -58,13 +69,39 @@ public:
         return m_raw;
     }
 
+    [[nodiscard]] static const char *get_path(const Type type) {
+        return FONT_PATHS[type];
+    }
+
     [[nodiscard]] int get_size() const {
         return m_size;
     }
 
+    /**
+     * Made on first use
+     */
+    [[nodiscard]] const GlyphAtlas &get_glyph_atlas(SDL_Renderer *renderer) {
+        if (m_glyph_atlas == nullptr)
+            m_glyph_atlas = std::make_unique<GlyphAtlas>(renderer, m_raw);
+
+        return *m_glyph_atlas;
+    }
+
+    /**
+     * Starts reading every font file in the background
+     */
+    static void request_assets() {
+        for (const char *path : FONT_PATHS)
+            AssetLoader::request_file(path);
+    }
+
+    [[nodiscard]] static int get_shared_size(const NameShared name, const int window_height) {
+        return window_height * SHARED_SIZE_FACTORS[name];
+    }
+
     void static make_shared(const int window_height) {
-        shared_fonts[PRIMARY] = std::make_shared<Font>(RUBIK_REGULAR, window_height * 0.025);
-        shared_fonts[SECONDARY] = std::make_shared<Font>(RUBIK_REGULAR, window_height * 0.02);
+        shared_fonts[PRIMARY] = std::make_shared<Font>(RUBIK_REGULAR, get_shared_size(PRIMARY, window_height));
+        shared_fonts[SECONDARY] = std::make_shared<Font>(RUBIK_REGULAR, get_shared_size(SECONDARY, window_height));
     }
 
     [[nodiscard]] static Shared get_shared(const NameShared name) {
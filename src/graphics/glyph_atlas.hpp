@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <SDL.h>
+#include <SDL_ttf.h>
+
+#include "texture.hpp"
+
+/**
+ * Every printable ASCII glyph of a font, rendered once in white into a single texture.
+ *
+ * Text is laid out from it as one quad per glyph, see TextLabel, so changing a text doesn't rasterize or upload
+ * anything.
+ */
+class GlyphAtlas {
+public:
+    struct Glyph {
+        SDL_Rect source;
+        int advance;
+    };
+
+    static constexpr char FIRST_GLYPH = ' ';
+    static constexpr char LAST_GLYPH = '~';
+    // Drawn for characters outside of the atlas
+    static constexpr char FALLBACK_GLYPH = '?';
+
+private:
+    static constexpr int GLYPHS = LAST_GLYPH - FIRST_GLYPH + 1;
+    static constexpr int GLYPHS_PER_ROW = 16;
+    // Transparent pixels around each glyph, so scaled glyphs don't sample their neighbours
+    static constexpr int PADDING = 1;
+
+    TTF_Font *m_font;
+    const int m_height;
+    Glyph m_glyphs[GLYPHS]{};
+    const Texture m_texture;
+
+public:
+    GlyphAtlas(SDL_Renderer *renderer, TTF_Font *font) :
+        m_font(font),
+        m_height(TTF_FontHeight(font)),
+        m_texture(renderer, make_atlas_surface(font, m_height, m_glyphs)) {}
+
+    [[nodiscard]] const Texture &get_texture() const {
+        return m_texture;
+    }
+
+    [[nodiscard]] int get_height() const {
+        return m_height;
+    }
+
+    [[nodiscard]] const Glyph &get(const char character) const {
+        if (character < FIRST_GLYPH || character > LAST_GLYPH)
+            return m_glyphs[FALLBACK_GLYPH - FIRST_GLYPH];
+
+        return m_glyphs[character - FIRST_GLYPH];
+    }
+
+    [[nodiscard]] int get_kerning(const char previous, const char character) const {
+        return TTF_GetFontKerningSizeGlyphs(m_font, previous, character);
+    }
+
+private:
+    /**
+     * Rows of GLYPHS_PER_ROW glyphs, each as wide as it renders
+     */
+    static SDL_Surface *make_atlas_surface(TTF_Font *font, const int height, Glyph (&glyphs)[GLYPHS]) {
+        constexpr SDL_Color white = {255, 255, 255, 255};
+        const int row_height = height + PADDING * 2;
+
+        SDL_Surface *glyph_surfaces[GLYPHS];
+        int atlas_width = 0;
+        int x = 0;
+
+        for (int i = 0; i < GLYPHS; i++) {
+            const char text[2] = {static_cast<char>(FIRST_GLYPH + i), 0};
+
+            if (i % GLYPHS_PER_ROW == 0)
+                x = 0;
+
+            glyph_surfaces[i] = TTF_RenderText_Blended(font, text, white);
+            TTF_GlyphMetrics(font, text[0], nullptr, nullptr, nullptr, nullptr, &glyphs[i].advance);
+
+            const int width = glyph_surfaces[i] != nullptr ? glyph_surfaces[i]->w : 0;
+            const int glyph_height = glyph_surfaces[i] != nullptr ? glyph_surfaces[i]->h : 0;
+
+            glyphs[i].source = {x + PADDING, i / GLYPHS_PER_ROW * row_height + PADDING, width, glyph_height};
+            x += width + PADDING * 2;
+            atlas_width = std::max(atlas_width, x);
+        }
+
+        const int rows = (GLYPHS + GLYPHS_PER_ROW - 1) / GLYPHS_PER_ROW;
+        SDL_Surface *atlas = SDL_CreateRGBSurfaceWithFormat(
+            0,
+            atlas_width,
+            rows * row_height,
+            32,
+            SDL_PIXELFORMAT_ARGB8888
+        );
+
+        SDL_FillRect(atlas, nullptr, 0);
+
+        for (int i = 0; i < GLYPHS; i++) {
+            if (glyph_surfaces[i] == nullptr)
+                continue;
+
+            SDL_Rect destination = glyphs[i].source;
+
+            // Copied as is, alpha included
+            SDL_SetSurfaceBlendMode(glyph_surfaces[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(glyph_surfaces[i], nullptr, atlas, &destination);
+            SDL_FreeSurface(glyph_surfaces[i]);
+        }
+
+        return atlas;
+    }
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "../core/game.hpp"
+
+/**
+ * Pixel layout of a game grid inside the window. Boards too big to fit with readable cells overflow the window, see
+ * Camera.
+ */
+class GridLayout {
+public:
+    // Fraction of the window the grid fills along its limiting side
+    static constexpr double WINDOW_FILL = 0.875;
+    // Smallest cell size, relative to the window height
+    static constexpr double MIN_CELL_SIZE_FACTOR = 1.0 / 40;
+
+    struct Measurements {
+        int cell_size = 0;
+        int grid_line_length = 0;
+        int grid_line_width = 0;
+        int grid_x_offset = 0;
+        int grid_y_offset = 0;
+        int grid_width = 0;
+        int grid_height = 0;
+    };
+
+private:
+    const Measurements m_measurements;
+
+public:
+    GridLayout(const int rows, const int columns, const int window_width, const int window_height) :
+        m_measurements(calculate_measurements(rows, columns, window_width, window_height)) {}
+
+    [[nodiscard]] const Measurements &get_measurements() const {
+        return m_measurements;
+    }
+
+private:
+    static Measurements calculate_measurements(
+        const int rows,
+        const int columns,
+        const int window_width,
+        const int window_height
+    ) {
+        const float grid_ratio = static_cast<double>(columns) / rows;
+        const float window_ratio = static_cast<double>(window_width) / window_height;
+
+        const int limitant_grid_side = grid_ratio > window_ratio ? columns : rows;
+        const int limitant_window_side = grid_ratio > window_ratio ? window_width : window_height;
+        const int cell_size = std::max(
+            lround(limitant_window_side * WINDOW_FILL / limitant_grid_side),
+            lround(window_height * MIN_CELL_SIZE_FACTOR)
+        );
+
+        const int grid_line_length = cell_size * 0.65;
+        const int grid_line_width = lround(cell_size * 0.03);
+        const int grid_width = cell_size * columns;
+        const int grid_x_offset = (window_width - grid_width) / 2;
+        const int grid_height = cell_size * rows;
+        const int grid_y_offset = lround((window_height - grid_height) / 2.0 + window_height * 0.0375);
+
+        return {
+            cell_size,
+            grid_line_length,
+            grid_line_width,
+            grid_x_offset,
+            grid_y_offset,
+            grid_width,
+            grid_height,
+        };
+    }
+};
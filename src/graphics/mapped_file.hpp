@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Whole file mapped read-only into memory, unmapped on destruction. Missing and empty files aren't mapped.
+ */
+class MappedFile {
+    const void *m_data = nullptr;
+    size_t m_size = 0;
+
+public:
+    explicit MappedFile(const char *path) {
+#ifdef _WIN32
+        const HANDLE file = CreateFileA(
+            path,
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr
+        );
+
+        if (file == INVALID_HANDLE_VALUE)
+            return;
+
+        LARGE_INTEGER size;
+
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+            const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+            if (mapping != nullptr) {
+                m_data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                m_size = m_data != nullptr ? static_cast<size_t>(size.QuadPart) : 0;
+                // The view keeps the mapping alive
+                CloseHandle(mapping);
+            }
+        }
+
+        CloseHandle(file);
+#else
+        const int file = open(path, O_RDONLY);
+
+        if (file < 0)
+            return;
+
+        struct stat status{};
+
+        if (fstat(file, &status) == 0 && status.st_size > 0) {
+            void *data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+            if (data != MAP_FAILED) {
+                m_data = data;
+                m_size = status.st_size;
+            }
+        }
+
+        // The mapping stays valid after closing the file
+        close(file);
+#endif
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile() {
+        if (m_data == nullptr)
+            return;
+
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+#else
+        munmap(const_cast<void *>(m_data), m_size);
+#endif
+    }
+
+    [[nodiscard]] bool is_open() const {
+        return m_data != nullptr;
+    }
+
+    [[nodiscard]] const unsigned char *get_data() const {
+        return static_cast<const unsigned char *>(m_data);
+    }
+
+    [[nodiscard]] size_t get_size() const {
+        return m_size;
+    }
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+#include "texture.hpp"
+
+/**
+ * Quads cut from a single texture, drawn with one SDL_RenderGeometry call instead of one copy each.
+ *
+ * The vertex and index buffers keep their capacity across clear(), so a batch reused every frame stops allocating
+ * after the first one.
+ */
+class SpriteBatch {
+    static constexpr SDL_Color WHITE = {255, 255, 255, 255};
+
+    SDL_Renderer *m_renderer;
+    SDL_Texture *m_texture;
+    float m_texture_width;
+    float m_texture_height;
+    std::vector<SDL_Vertex> m_vertices{};
+    std::vector<int> m_indices{};
+
+public:
+    SpriteBatch(SDL_Renderer *renderer, const Texture &texture) :
+        m_renderer(renderer),
+        m_texture(texture.get_raw()),
+        m_texture_width(static_cast<float>(texture.get_w())),
+        m_texture_height(static_cast<float>(texture.get_h())) {}
+
+    [[nodiscard]] size_t get_size() const {
+        return m_indices.size() / 6;
+    }
+
+    void clear() {
+        m_vertices.clear();
+        m_indices.clear();
+    }
+
+    /**
+     * Stretches source, in texture pixels, over destination, in window pixels. The color multiplies the texture's.
+     */
+    void add(const SDL_Rect &source, const SDL_FRect &destination, const SDL_Color color = WHITE) {
+        const int first = static_cast<int>(m_vertices.size());
+
+        const float left = destination.x;
+        const float top = destination.y;
+        const float right = destination.x + destination.w;
+        const float bottom = destination.y + destination.h;
+
+        const float u0 = source.x / m_texture_width;
+        const float v0 = source.y / m_texture_height;
+        const float u1 = (source.x + source.w) / m_texture_width;
+        const float v1 = (source.y + source.h) / m_texture_height;
+
+        m_vertices.push_back({{left, top}, color, {u0, v0}});
+        m_vertices.push_back({{right, top}, color, {u1, v0}});
+        m_vertices.push_back({{right, bottom}, color, {u1, v1}});
+        m_vertices.push_back({{left, bottom}, color, {u0, v1}});
+
+        m_indices.insert(m_indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+    }
+
+    void render() const {
+        if (m_indices.empty())
+            return;
+
+        SDL_RenderGeometry(
+            m_renderer,
+            m_texture,
+            m_vertices.data(),
+            static_cast<int>(m_vertices.size()),
+            m_indices.data(),
+            static_cast<int>(m_indices.size())
+        );
+    }
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <SDL.h>
+#include <string>
+#include <string_view>
+
+#include "color.hpp"
+#include "font.hpp"
+#include "glyph_atlas.hpp"
+#include "sprite_batch.hpp"
+
+/**
+ * Single line of text drawn from its font's GlyphAtlas, for text that changes often.
+ *
+ * Updating the text or moving it only lays out the glyph quads again, reusing the same buffers, so it doesn't
+ * allocate once the text has been as long before.
+ */
+class TextLabel {
+    const GlyphAtlas &m_atlas;
+    SpriteBatch m_batch;
+    const SDL_Color m_color;
+    SDL_Rect m_area{0, 0, 0, 0};
+    std::string m_text{};
+
+public:
+    TextLabel(
+        SDL_Renderer *renderer,
+        Font &font,
+        const std::string_view text,
+        const Color::Name color,
+        const SDL_Point position = {0, 0}
+    ) : m_atlas(font.get_glyph_atlas(renderer)),
+        m_batch(renderer, m_atlas.get_texture()),
+        m_color(Color::get(color).get_rgb()),
+        m_area{position.x, position.y, 0, m_atlas.get_height()},
+        m_text(text) {
+        layout();
+    }
+
+    [[nodiscard]] int get_x() const {
+        return m_area.x;
+    }
+
+    [[nodiscard]] int get_y() const {
+        return m_area.y;
+    }
+
+    [[nodiscard]] int get_w() const {
+        return m_area.w;
+    }
+
+    [[nodiscard]] int get_h() const {
+        return m_area.h;
+    }
+
+    void set_position(const int x, const int y) {
+        m_area.x = x;
+        m_area.y = y;
+        layout();
+    }
+
+    void set_x(const int x) {
+        set_position(x, m_area.y);
+    }
+
+    void update_text(const std::string_view text) {
+        m_text.assign(text);
+        layout();
+    }
+
+    void render() const {
+        m_batch.render();
+    }
+
+private:
+    void layout() {
+        m_batch.clear();
+
+        int pen = 0;
+
+        for (size_t i = 0; i < m_text.size(); i++) {
+            const GlyphAtlas::Glyph &glyph = m_atlas.get(m_text[i]);
+
+            if (i > 0)
+                pen += m_atlas.get_kerning(m_text[i - 1], m_text[i]);
+
+            m_batch.add(
+                glyph.source,
+                {
+                    static_cast<float>(m_area.x + pen),
+                    static_cast<float>(m_area.y),
+                    static_cast<float>(glyph.source.w),
+                    static_cast<float>(glyph.source.h),
+                },
+                m_color
+            );
+
+            pen += glyph.advance;
+        }
+
+        m_area.w = pen;
+    }
+};
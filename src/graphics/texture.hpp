@@ -1,10 +1,9 @@
 #pragma once
 
 #include <SDL.h>
-#include <SDL_image.h>
-#include <SDL2_rotozoom.h>
 #include <string>
 
+#include "asset_loader.hpp"
 #include "color.hpp"
 
 constexpr SDL_Rect NULL_RECT = {0, 0, 0, 0};
@@ -55,18 +54,59 @@ public:
         m_texture = SDL_CreateTexture(m_renderer, pixel_format, access, m_area.w, m_area.h);
     }
 
+    /**
+     * Takes ownership of the surface
+     */
+    Texture(SDL_Renderer *renderer, SDL_Surface *surface) : m_renderer(renderer), m_surface(surface) {
+        m_texture = SDL_CreateTextureFromSurface(m_renderer, m_surface);
+        m_area = {0, 0, m_surface->w, m_surface->h};
+    }
+
+    /**
+     * Static ARGB8888 texture uploaded from the given pixels
+     */
+    Texture(
+        SDL_Renderer *renderer,
+        const SDL_Rect area,
+        const void *pixels,
+        const int pitch
+    ) : m_renderer(renderer),
+        m_area(area) {
+        m_texture = SDL_CreateTexture(
+            m_renderer,
+            SDL_PIXELFORMAT_ARGB8888,
+            SDL_TEXTUREACCESS_STATIC,
+            m_area.w,
+            m_area.h
+        );
+        SDL_UpdateTexture(m_texture, nullptr, pixels, pitch);
+        SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_BLEND);
+    }
+
+    /**
+     * Images come from the AssetLoader, decoded and scaled on a worker thread if they were requested
+     */
     Texture(SDL_Renderer *renderer, const char *image_path) : m_renderer(renderer) {
-        m_surface = IMG_Load(image_path);
+        m_surface = AssetLoader::get_image(image_path);
         m_texture = SDL_CreateTextureFromSurface(m_renderer, m_surface);
         m_area = {0, 0, m_surface->w, m_surface->h};
     }
 
+    /**
+     * Stretched over the area
+     */
     Texture(SDL_Renderer *renderer, const char *image_path, const SDL_Rect area) : m_renderer(renderer), m_area(area) {
-        m_surface = IMG_Load(image_path);
+        m_surface = AssetLoader::get_image(image_path, {area.w, area.h});
         m_texture = SDL_CreateTextureFromSurface(m_renderer, m_surface);
-        m_area.w = m_surface->w;
-        m_area.h = m_surface->h;
-        scale(static_cast<double>(area.w) / m_area.w, static_cast<double>(area.h) / m_area.h);
+    }
+
+    /**
+     * Keeps the aspect ratio
+     */
+    Texture(SDL_Renderer *renderer, const char *image_path, const int height) : m_renderer(renderer) {
+        m_surface = AssetLoader::get_image(image_path, {0, height});
+        m_texture = SDL_CreateTextureFromSurface(m_renderer, m_surface);
+        m_area = {0, 0, m_surface->w * height / m_surface->h, height};
     }
 
     Texture(
@@ -107,6 +147,22 @@ public:
         return m_area;
     }
 
+    [[nodiscard]] SDL_Texture *get_raw() const {
+        return m_texture;
+    }
+
+    /**
+     * Bytes the texture takes on the GPU, estimated at 4 per pixel
+     */
+    [[nodiscard]] size_t get_memory_size() const {
+        int width = 0, height = 0;
+
+        if (m_texture != nullptr)
+            SDL_QueryTexture(m_texture, nullptr, nullptr, &width, &height);
+
+        return static_cast<size_t>(width) * height * 4;
+    }
+
     [[nodiscard]] bool contains(const SDL_Point point) const {
         const auto [x, y] = point;
         const auto [ax, ay, w, h] = m_area;
@@ -123,23 +179,12 @@ public:
         if (zoom_x == 1 && zoom_y == 1)
             return;
 
-        SDL_Surface *new_surface;
-
-        if (zoom_x < 1 && zoom_y < 1) {
-            const double factor_x = 1 / zoom_x;
-            const double factor_y = 1 / zoom_y;
-            const int factor_x_int = factor_x;
-            const int factor_y_int = factor_y;
-
-            if (factor_x != factor_x_int || factor_x_int != factor_y_int) {
-                m_area.w *= zoom_x;
-                m_area.h *= zoom_y;
-                return;
-            }
+        SDL_Surface *new_surface = AssetLoader::scale_surface(m_surface, zoom_x, zoom_y);
 
-            new_surface = shrinkSurface(m_surface, factor_x_int, factor_y_int);
-        } else {
-            new_surface = zoomSurface(m_surface, zoom_x, zoom_x, SMOOTHING_ON);
+        if (new_surface == nullptr) {
+            m_area.w *= zoom_x;
+            m_area.h *= zoom_y;
+            return;
         }
 
         destroy();
@@ -182,6 +227,10 @@ public:
         set_color(Color::get(color).get_rgb());
     }
 
+    void set_blend_mode(const SDL_BlendMode blend_mode) const {
+        SDL_SetTextureBlendMode(m_texture, blend_mode);
+    }
+
     [[nodiscard]] ScopedRender set_as_render_target(const SDL_BlendMode blend_mode = SDL_BLENDMODE_BLEND) const {
         return {m_renderer, m_texture, blend_mode};
     }
@@ -213,6 +262,13 @@ public:
         SDL_RenderCopy(m_renderer, m_texture, nullptr, &destination);
     }
 
+    /**
+     * Stretched over the whole destination
+     */
+    void render_to(const SDL_Rect &destination) const {
+        SDL_RenderCopy(m_renderer, m_texture, nullptr, &destination);
+    }
+
     void destroy() {
         SDL_FreeSurface(m_surface);
         m_surface = nullptr;
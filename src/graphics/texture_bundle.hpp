@@ -50,6 +50,15 @@ public:
         return m_position.y;
     }
 
+    [[nodiscard]] size_t get_memory_size() const {
+        size_t size = 0;
+
+        for (const auto &texture : m_textures)
+            size += texture->get_memory_size();
+
+        return size;
+    }
+
     [[nodiscard]] int get_h() const {
         int height = 0;
 
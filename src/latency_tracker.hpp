@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+/**
+ * Measures how long input takes to reach the screen.
+ *
+ * Every input event is timestamped when it's polled. The next frame's latency goes from the oldest of them to the
+ * return of SDL_RenderPresent, split into the time spent in the screen's event handlers, in render() and in the
+ * present itself. Frames without input aren't recorded.
+ *
+ * Percentiles come from a histogram of every recorded frame, the per-frame breakdown is kept for the latest
+ * MAX_FRAMES frames for dump_csv().
+ */
+class LatencyTracker {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * Times in milliseconds
+     */
+    struct Frame {
+        double input_to_present;
+        double handling;
+        double rendering;
+        double presenting;
+    };
+
+    /**
+     * Of input_to_present, in milliseconds
+     */
+    struct Percentiles {
+        uint64_t frames;
+        double p50;
+        double p95;
+        double p99;
+    };
+
+    static constexpr size_t MAX_FRAMES = 100000;
+
+private:
+    static constexpr double BUCKET_MS = 0.1;
+    // Up to a second, slower frames go in the last bucket
+    static constexpr int BUCKETS = 10000;
+
+    std::vector<uint32_t> m_histogram = std::vector<uint32_t>(BUCKETS, 0);
+    std::vector<Frame> m_frames{};
+    uint64_t m_frame_count = 0;
+    bool m_pending_input = false;
+    clock::time_point m_oldest_input{};
+    clock::duration m_handling = clock::duration::zero();
+
+public:
+    [[nodiscard]] uint64_t get_frame_count() const {
+        return m_frame_count;
+    }
+
+    /**
+     * An input event polled at the given time was just handled
+     */
+    void input_handled(const clock::time_point polled) {
+        if (!m_pending_input) {
+            m_pending_input = true;
+            m_oldest_input = polled;
+        }
+
+        m_handling += clock::now() - polled;
+    }
+
+    /**
+     * A frame was presented, with render() called at render_start and SDL_RenderPresent at present_start
+     */
+    void frame_presented(const clock::time_point render_start, const clock::time_point present_start) {
+        if (!m_pending_input)
+            return;
+
+        const clock::time_point present_end = clock::now();
+        const Frame frame = {
+            to_milliseconds(present_end - m_oldest_input),
+            to_milliseconds(m_handling),
+            to_milliseconds(present_start - render_start),
+            to_milliseconds(present_end - present_start),
+        };
+
+        m_histogram[std::min(static_cast<int>(frame.input_to_present / BUCKET_MS), BUCKETS - 1)]++;
+
+        if (m_frames.size() < MAX_FRAMES)
+            m_frames.push_back(frame);
+        else
+            m_frames[m_frame_count % MAX_FRAMES] = frame;
+
+        m_frame_count++;
+        m_pending_input = false;
+        m_handling = clock::duration::zero();
+    }
+
+    [[nodiscard]] Percentiles get_percentiles() const {
+        return {m_frame_count, get_percentile(0.5), get_percentile(0.95), get_percentile(0.99)};
+    }
+
+    /**
+     * Writes the kept frames, oldest first. Returns false if the file can't be written.
+     */
+    bool dump_csv(const char *path) const {
+        std::ofstream file(path);
+
+        if (!file)
+            return false;
+
+        file << "frame,input_to_present_ms,handling_ms,rendering_ms,presenting_ms\n";
+
+        const uint64_t first = m_frame_count - m_frames.size();
+
+        for (uint64_t i = first; i < m_frame_count; i++) {
+            const auto &[input_to_present, handling, rendering, presenting] = m_frames[i % MAX_FRAMES];
+            file << i << ',' << input_to_present << ',' << handling << ',' << rendering << ',' << presenting << '\n';
+        }
+
+        return static_cast<bool>(file);
+    }
+
+private:
+    /**
+     * Upper edge of the bucket holding the percentile, so it errs on the slow side
+     */
+    [[nodiscard]] double get_percentile(const double percentile) const {
+        if (m_frame_count == 0)
+            return 0;
+
+        const auto rank = static_cast<uint64_t>(std::ceil(percentile * static_cast<double>(m_frame_count)));
+        uint64_t count = 0;
+
+        for (int i = 0; i < BUCKETS; i++) {
+            count += m_histogram[i];
+
+            if (count >= rank)
+                return (i + 1) * BUCKET_MS;
+        }
+
+        return BUCKETS * BUCKET_MS;
+    }
+
+    static double to_milliseconds(const clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+};
@@ -1,5 +1,8 @@
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <optional>
 #include <SDL.h>
 #include <SDL_image.h>
 #include <SDL_ttf.h>
@@ -8,25 +11,109 @@
 #include "core/settings.hpp"
 #include "screens/main_menu_screen.hpp"
 
+struct Options {
+    // Display refresh rate if not set
+    std::optional<int> target_fps{};
+    bool frame_stats = false;
+    const char *latency_csv_path = nullptr;
+};
+
+static constexpr auto USAGE = R"(Usage: minesweeper [options]
+
+Options:
+      --fps <fps|uncapped>  Frames per second to render at most (default the display refresh rate)
+      --frame-stats         Print frame time statistics on exit
+      --latency-csv <path>  Write the input latency of every frame to a CSV file on exit
+  -h, --help                Show this message
+)";
+
+[[noreturn]] void exit_with_usage(const char *error);
+Options parse_options(int argc, char *argv[]);
+void print_frame_stats(const FrameScheduler::Stats &stats);
 EngineParameters start_sdl();
 void quit_sdl(SDL_Renderer *renderer, SDL_Window *window);
 void throw_sdl_error(const char *function_name, int code = 0);
 
-// ReSharper disable CppParameterNeverUsed
 int main(int argc, char *argv[]) {
+    const Options options = parse_options(argc, argv);
+
     Settings::load();
 
     const EngineParameters parameters = start_sdl();
 
     Engine engine(parameters);
+
+    if (options.target_fps)
+        engine.set_target_fps(*options.target_fps);
+
     engine.set_screen<MainMenuScreen>(&engine);
     engine.run();
 
+    if (options.frame_stats)
+        print_frame_stats(engine.get_frame_stats());
+
+    if (options.latency_csv_path != nullptr && !engine.get_latency_tracker().dump_csv(options.latency_csv_path))
+        std::cerr << "Couldn't write " << options.latency_csv_path << std::endl;
+
     quit_sdl(parameters.renderer, parameters.window);
 
     return 0;
 }
 
+void exit_with_usage(const char *error) {
+    if (error != nullptr)
+        std::cerr << "minesweeper: " << error << "\n\n";
+
+    (error != nullptr ? std::cerr : std::cout) << USAGE;
+    exit(error != nullptr ? 1 : 0);
+}
+
+Options parse_options(const int argc, char *argv[]) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char *option = argv[i];
+
+        if (strcmp(option, "-h") == 0 || strcmp(option, "--help") == 0)
+            exit_with_usage(nullptr);
+
+        if (strcmp(option, "--frame-stats") == 0) {
+            options.frame_stats = true;
+            continue;
+        }
+
+        if (strcmp(option, "--fps") != 0 && strcmp(option, "--latency-csv") != 0)
+            exit_with_usage((std::string("unknown option ") + option).c_str());
+
+        if (i + 1 == argc)
+            exit_with_usage((std::string("missing value for ") + option).c_str());
+
+        const char *value = argv[++i];
+
+        if (strcmp(option, "--latency-csv") == 0) {
+            options.latency_csv_path = value;
+            continue;
+        }
+
+        if (strcmp(value, "uncapped") == 0) {
+            options.target_fps = FrameScheduler::UNCAPPED;
+            continue;
+        }
+
+        options.target_fps = atoi(value);
+        if (*options.target_fps <= 0)
+            exit_with_usage("fps must be positive or uncapped");
+    }
+
+    return options;
+}
+
+void print_frame_stats(const FrameScheduler::Stats &stats) {
+    std::cout << stats.frames << " frames, last " << std::min<uint64_t>(stats.frames, FrameScheduler::STATS_FRAMES)
+            << " in ms: mean " << stats.average << ", p50 " << stats.p50 << ", p95 " << stats.p95 << ", max "
+            << stats.max << std::endl;
+}
+
 EngineParameters start_sdl() {
     const int sdl_init_error = SDL_Init(SDL_INIT_VIDEO);
     if (sdl_init_error < 0)
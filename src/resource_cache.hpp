@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Keeps resources, like texture managers, alive across screens so coming back to a screen doesn't make them again.
+ *
+ * Entries are kept in least recently used order. Once their memory adds up to more than the budget, the least recently
+ * used ones nobody else holds are freed. Resources tell their size with get_memory_size().
+ */
+class ResourceCache {
+public:
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+
+private:
+    struct Entry {
+        std::string key;
+        std::shared_ptr<void> resource;
+        size_t memory_size;
+    };
+
+    const size_t m_memory_budget;
+    size_t m_memory_size = 0;
+    // Most recently used first
+    std::list<Entry> m_entries{};
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_entries_by_key{};
+
+public:
+    explicit ResourceCache(const size_t memory_budget = DEFAULT_MEMORY_BUDGET) : m_memory_budget(memory_budget) {}
+
+    [[nodiscard]] size_t get_memory_size() const {
+        return m_memory_size;
+    }
+
+    /**
+     * The resource cached with the key, made from the arguments if there's none. Keys must be unique across types.
+     */
+    template<typename T, typename... Args>
+    std::shared_ptr<T> get(const std::string &key, Args &&... args) {
+        const auto found = m_entries_by_key.find(key);
+
+        if (found != m_entries_by_key.end()) {
+            m_entries.splice(m_entries.begin(), m_entries, found->second);
+            return std::static_pointer_cast<T>(found->second->resource);
+        }
+
+        const auto resource = std::make_shared<T>(std::forward<Args>(args)...);
+        const size_t memory_size = resource->get_memory_size();
+
+        m_entries.push_front({key, resource, memory_size});
+        m_entries_by_key.emplace(key, m_entries.begin());
+        m_memory_size += memory_size;
+
+        trim();
+
+        return resource;
+    }
+
+    /**
+     * Resources still held elsewhere stay alive until released
+     */
+    void clear() {
+        m_entries.clear();
+        m_entries_by_key.clear();
+        m_memory_size = 0;
+    }
+
+    /**
+     * Frees unused entries from the least recently used one until it's within the budget
+     */
+    void trim() {
+        auto entry = m_entries.end();
+
+        while (m_memory_size > m_memory_budget && entry != m_entries.begin()) {
+            --entry;
+
+            if (entry->resource.use_count() > 1)
+                continue;
+
+            m_memory_size -= entry->memory_size;
+            m_entries_by_key.erase(entry->key);
+            entry = m_entries.erase(entry);
+        }
+    }
+};
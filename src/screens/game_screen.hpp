@@ -1,11 +1,24 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <climits>
 #include <ctime>
-#include <iostream>
+#include <future>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "screen.hpp"
 #include "../core/game.hpp"
+#include "../core/no_guess_pool.hpp"
+#include "../core/probability_engine.hpp"
+#include "../core/solver.hpp"
+#include "../graphics/camera.hpp"
+#include "../graphics/grid_layout.hpp"
+#include "../graphics/shape.hpp"
+#include "../graphics/sprite_batch.hpp"
 #include "../texture_managers/game_texture_manager.hpp"
 
 class Engine;
@@ -13,6 +26,10 @@ class MainMenuScreen;
 
 class GameScreen final : virtual public Screen {
     using GameTexture = GameTextureManager::GameTexture;
+    using GameText = GameTextureManager::GameText;
+    using Sprite = GameTextureManager::Sprite;
+    using SpriteName = GameTextureManager::SpriteName;
+    using TextName = GameTextureManager::TextName;
     using TextureName = GameTextureManager::TextureName;
     using TextureBundleName = GameTextureManager::TextureBundleName;
 
@@ -20,10 +37,38 @@ class GameScreen final : virtual public Screen {
     int m_window_width;
     int m_window_height;
     Game m_game;
-    GameTextureManager m_texture_manager;
+    Solver m_solver;
+    ProbabilityEngine m_probability_engine;
+    GridLayout m_layout;
+    Camera m_camera;
+    std::shared_ptr<GameTextureManager> m_texture_manager;
+    SpriteBatch m_sprite_batch;
+    // Grid as last drawn, see render_grid()
+    Texture m_board_texture;
+    bool m_board_outdated = true;
+    std::vector<Game::GridCoords> m_dirty_cells{};
+    // Covered neighbours flagged like each cell, updated with the cells, see get_neighbour_mask()
+    std::vector<uint8_t> m_neighbour_masks;
     bool m_started_game;
+    bool m_no_guess = false;
+    // Mines placed in the background while the board waits for its first click
+    std::future<Game::PreparedGrid> m_prepared_grid{};
+    // No-guess layout still being searched for the first click
+    std::future<std::vector<int>> m_pending_layout{};
+    Game::GridCoords m_pending_click{};
+    bool m_show_probabilities = false;
+    bool m_probabilities_outdated = true;
+    std::vector<float> m_probabilities{};
     time_t m_last_game_time_rendered = 0;
-    int m_remaining_mines = 0;
+    // The texts may be left over from another game, see ResourceCache
+    int m_remaining_mines = INT_MIN;
+
+    static constexpr SDL_Keycode PROBABILITIES_KEY = SDLK_h;
+    static constexpr SDL_Keycode RESET_CAMERA_KEY = SDLK_0;
+    static constexpr Uint8 PROBABILITIES_ALPHA = 112;
+    // Past this, one batch for the whole board beats a draw call per cell
+    static constexpr size_t MAX_DIRTY_CELLS = 256;
+    static constexpr std::chrono::milliseconds PENDING_LAYOUT_POLL_INTERVAL{10};
 
     static bool selected_dig_action;
 
@@ -31,40 +76,102 @@ class GameScreen final : virtual public Screen {
     SDL_Cursor *const m_hand_cursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_HAND);
 
 public:
-    explicit GameScreen(Engine *engine, const Game::Difficulty difficulty) :
+    explicit GameScreen(Engine *engine, const Game::Difficulty difficulty, const bool no_guess = false) :
         m_engine(engine),
         m_window_width(engine->get_window_width()),
         m_window_height(engine->get_window_height()),
-        m_game(difficulty, engine->get_window_width(), engine->get_window_height()),
-        m_texture_manager(
+        m_game(difficulty),
+        m_solver(m_game),
+        m_probability_engine(m_solver),
+        m_layout(m_game.get_rows(), m_game.get_columns(), m_window_width, m_window_height),
+        m_camera(m_game.get_rows(), m_game.get_columns(), m_layout.get_measurements(), m_window_width, m_window_height),
+        m_texture_manager(engine->get_resource_cache().get<GameTextureManager>(
+            GameTextureManager::make_cache_key(m_layout.get_measurements(), difficulty, m_window_width, m_window_height),
             engine->get_renderer(),
-            m_game.get_measurements(),
+            m_layout.get_measurements(),
             difficulty,
             m_window_width,
             m_window_height
-        ),
-        m_started_game(false) {}
+        )),
+        m_sprite_batch(engine->get_renderer(), m_texture_manager->get_atlas()),
+        m_board_texture(engine->get_renderer(), SDL_Rect{0, 0, m_window_width, m_window_height}),
+        m_neighbour_masks(m_game.get_rows() * m_game.get_columns()),
+        m_started_game(false),
+        m_no_guess(no_guess) {
+        update_neighbour_masks();
+
+        if (!m_no_guess)
+            m_prepared_grid = std::async(
+                std::launch::async,
+                Game::prepare_grid,
+                m_game.get_rows(),
+                m_game.get_columns(),
+                m_game.get_total_mines(),
+                m_game.get_seed()
+            );
+    }
 
     explicit GameScreen(Engine *engine, const Game &game) :
         m_engine(engine),
         m_window_width(engine->get_window_width()),
         m_window_height(engine->get_window_height()),
         m_game(game),
-        m_texture_manager(
+        m_solver(m_game),
+        m_probability_engine(m_solver),
+        m_layout(m_game.get_rows(), m_game.get_columns(), m_window_width, m_window_height),
+        m_camera(m_game.get_rows(), m_game.get_columns(), m_layout.get_measurements(), m_window_width, m_window_height),
+        m_texture_manager(engine->get_resource_cache().get<GameTextureManager>(
+            GameTextureManager::make_cache_key(m_layout.get_measurements(), m_game.get_difficulty(), m_window_width, m_window_height),
             engine->get_renderer(),
-            m_game.get_measurements(),
+            m_layout.get_measurements(),
             m_game.get_difficulty(),
             m_window_width,
             m_window_height
-        ),
-        m_started_game(true) {}
+        )),
+        m_sprite_batch(engine->get_renderer(), m_texture_manager->get_atlas()),
+        m_board_texture(engine->get_renderer(), SDL_Rect{0, 0, m_window_width, m_window_height}),
+        m_neighbour_masks(m_game.get_rows() * m_game.get_columns()),
+        m_started_game(true) {
+        update_neighbour_masks();
+    }
 
     ~GameScreen() override = default;
 
-    void before_event(const SDL_Event &event) override {}
+    /**
+     * Called with the constructor's arguments before making the screen, see Engine::set_screen()
+     */
+    static void request_assets(Engine *engine, const Game::Difficulty difficulty, const bool = false) {
+        const auto &[rows, columns, mines] = Game::DIFFICULTY_TO_SETTING[difficulty];
+        request_board_assets(engine, rows, columns);
+    }
+
+    static void request_assets(Engine *engine, const Game &game) {
+        request_board_assets(engine, game.get_rows(), game.get_columns());
+    }
+
+    void before_event(const SDL_Event &event) override {
+        // Some backends lose the contents of render targets
+        if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+            m_board_outdated = true;
+    }
 
     void on_keyboard_event(const SDL_KeyboardEvent &event) override {
-        if (event.type != SDL_KEYDOWN || event.keysym.sym != SDLK_ESCAPE)
+        if (event.type != SDL_KEYDOWN)
+            return;
+
+        if (event.keysym.sym == PROBABILITIES_KEY) {
+            m_show_probabilities = !m_show_probabilities;
+            m_board_outdated = true;
+            return;
+        }
+
+        if (event.keysym.sym == RESET_CAMERA_KEY) {
+            m_camera.reset();
+            m_board_outdated = true;
+            return;
+        }
+
+        if (event.keysym.sym != SDLK_ESCAPE)
             return;
 
         if (m_game.has_started() && !m_game.is_over())
@@ -83,13 +190,13 @@ public:
         SDL_Point cursor_pos;
         SDL_GetMouseState(&cursor_pos.x, &cursor_pos.y);
 
-        const bool cursor_in_back_button = m_texture_manager.get(TextureName::BACK_BUTTON)->contains(cursor_pos);
+        const bool cursor_in_back_button = m_texture_manager->get(TextureName::BACK_BUTTON)->contains(cursor_pos);
 
         const bool curor_in_flag_action_toggle = single_click_controls
-                && m_texture_manager.get(TextureName::ACTION_TOGGLE_FLAG)->contains(cursor_pos);
+                && m_texture_manager->get(TextureName::ACTION_TOGGLE_FLAG)->contains(cursor_pos);
 
         const bool curor_in_mine_action_toggle = single_click_controls
-                && m_texture_manager.get(TextureName::ACTION_TOGGLE_MINE)->contains(cursor_pos);
+                && m_texture_manager->get(TextureName::ACTION_TOGGLE_MINE)->contains(cursor_pos);
 
         if (cursor_in_back_button) {
             if (event.button != SDL_BUTTON_LEFT)
@@ -118,9 +225,9 @@ public:
             return;
         }
 
-        const auto [x, y, inside_cell] = m_game.calculate_grid_cell(cursor_pos.x, cursor_pos.y);
+        const auto [x, y, inside_cell] = m_camera.calculate_grid_cell(cursor_pos.x, cursor_pos.y);
 
-        if (!inside_cell || m_game.is_over())
+        if (!inside_cell || m_game.is_over() || m_pending_layout.valid())
             return;
 
         const bool left_click = event.button == (swapped_controls ? SDL_BUTTON_RIGHT : SDL_BUTTON_LEFT);
@@ -130,54 +237,57 @@ public:
                 return;
 
             if (!m_started_game) {
-                m_game.place_grid_mines(x, y);
-                m_started_game = true;
-                m_game.reveal_cell(x, y);
+                start_game(x, y);
                 return;
             }
 
             if (selected_dig_action) {
-                m_game.reveal_cell(x, y);
+                reveal_cell(x, y);
                 return;
             }
 
-            m_game.toggle_cell_flag(x, y);
+            toggle_cell_flag(x, y);
 
             if (m_game.get_grid_cell(x, y).revealed)
-                m_game.reveal_cell(x, y);
+                reveal_cell(x, y);
 
             return;
         }
 
         if (left_click) {
             if (!m_started_game) {
-                m_game.place_grid_mines(x, y);
-                m_started_game = true;
+                start_game(x, y);
+                return;
             }
 
-            m_game.reveal_cell(x, y);
+            reveal_cell(x, y);
             return;
         }
 
         if (!m_started_game)
             return;
 
-        m_game.toggle_cell_flag(x, y);
+        toggle_cell_flag(x, y);
     }
 
     void on_mouse_motion_event(const SDL_MouseMotionEvent &event) override {
+        if (event.state & SDL_BUTTON_MMASK) {
+            m_camera.pan(event.xrel, event.yrel);
+            m_board_outdated = true;
+        }
+
         const bool single_click_controls = Settings::is_on(Settings::SINGLE_CLICK_CONTROLS);
 
         SDL_Point cursor_pos;
         SDL_GetMouseState(&cursor_pos.x, &cursor_pos.y);
 
-        const bool cursor_in_back_button = m_texture_manager.get(TextureName::BACK_BUTTON)->contains(cursor_pos);
+        const bool cursor_in_back_button = m_texture_manager->get(TextureName::BACK_BUTTON)->contains(cursor_pos);
 
         const bool curor_in_flag_action_toggle = single_click_controls
-                && m_texture_manager.get(TextureName::ACTION_TOGGLE_FLAG)->contains(cursor_pos);
+                && m_texture_manager->get(TextureName::ACTION_TOGGLE_FLAG)->contains(cursor_pos);
 
         const bool curor_in_mine_action_toggle = single_click_controls
-                && m_texture_manager.get(TextureName::ACTION_TOGGLE_MINE)->contains(cursor_pos);
+                && m_texture_manager->get(TextureName::ACTION_TOGGLE_MINE)->contains(cursor_pos);
 
         SDL_SetCursor(
             cursor_in_back_button || curor_in_flag_action_toggle || curor_in_mine_action_toggle
@@ -186,7 +296,13 @@ public:
         );
     }
 
-    void on_mouse_wheel_event(const SDL_MouseWheelEvent &event) override {}
+    void on_mouse_wheel_event(const SDL_MouseWheelEvent &event) override {
+        SDL_Point cursor_pos;
+        SDL_GetMouseState(&cursor_pos.x, &cursor_pos.y);
+
+        m_camera.zoom_at(cursor_pos.x, cursor_pos.y, event.y);
+        m_board_outdated = true;
+    }
 
     void on_quit_event(const SDL_QuitEvent &event) override {
         if (m_game.has_started() && !m_game.is_over())
@@ -196,6 +312,19 @@ public:
     void render() override {
         const bool single_click_controls = Settings::is_on(Settings::SINGLE_CLICK_CONTROLS);
 
+        if (m_pending_layout.valid()) {
+            if (m_pending_layout.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                start_game(m_pending_click.x, m_pending_click.y, m_pending_layout.get());
+            else
+                m_engine->request_redraw(PENDING_LAYOUT_POLL_INTERVAL);
+        }
+
+        if (m_show_probabilities && m_probabilities_outdated) {
+            m_probabilities = m_probability_engine.probabilities();
+            m_probabilities_outdated = false;
+            m_board_outdated = true;
+        }
+
         render_grid();
         render_remaining_mines();
 
@@ -203,99 +332,297 @@ public:
             render_game_time();
 
         if (Settings::is_on(Settings::SHOW_CONTROLS)) {
-            m_texture_manager.get(TextureName::MOUSE_LEFT_ICON)->render();
-            m_texture_manager.get(TextureName::MOUSE_LEFT_TEXT)->render();
+            m_texture_manager->get(TextureName::MOUSE_LEFT_ICON)->render();
+            m_texture_manager->get(TextureName::MOUSE_LEFT_TEXT)->render();
 
             if (!single_click_controls) {
-                m_texture_manager.get(TextureName::MOUSE_RIGHT_ICON)->render();
-                m_texture_manager.get(TextureName::MOUSE_RIGHT_TEXT)->render();
+                m_texture_manager->get(TextureName::MOUSE_RIGHT_ICON)->render();
+                m_texture_manager->get(TextureName::MOUSE_RIGHT_TEXT)->render();
             }
         }
 
         if (single_click_controls) {
-            m_texture_manager.get(TextureName::ACTION_TOGGLE)->render();
+            m_texture_manager->get(TextureName::ACTION_TOGGLE)->render();
 
             if (selected_dig_action) {
-                m_texture_manager.get(TextureName::ACTION_TOGGLE_MINE_SELECTED)->render();
-                m_texture_manager.get(TextureName::ACTION_TOGGLE_FLAG)->render();
+                m_texture_manager->get(TextureName::ACTION_TOGGLE_MINE_SELECTED)->render();
+                m_texture_manager->get(TextureName::ACTION_TOGGLE_FLAG)->render();
             } else {
-                m_texture_manager.get(TextureName::ACTION_TOGGLE_FLAG_SELECTED)->render();
-                m_texture_manager.get(TextureName::ACTION_TOGGLE_MINE)->render();
+                m_texture_manager->get(TextureName::ACTION_TOGGLE_FLAG_SELECTED)->render();
+                m_texture_manager->get(TextureName::ACTION_TOGGLE_MINE)->render();
             }
         }
 
-        m_texture_manager.get(TextureName::BACK_BUTTON)->render();
+        m_texture_manager->get(TextureName::BACK_BUTTON)->render();
 
         if (!m_started_game)
-            m_texture_manager.get(TextureName::CLICK_TO_START)->render();
+            m_texture_manager->get(TextureName::CLICK_TO_START)->render();
 
         if (m_game.is_over() && !m_game.has_won()) {
-            m_texture_manager.get(TextureBundleName::GAME_LOST)->render();
+            m_texture_manager->get(TextureBundleName::GAME_LOST)->render();
         }
     }
 
 private:
-    void render_grid() const {
-        const bool show_cell_borders = Settings::is_on(Settings::SHOW_CELL_BORDERS);
+    static void request_board_assets(Engine *engine, const int rows, const int columns) {
+        const int window_width = engine->get_window_width();
+        const int window_height = engine->get_window_height();
+        const GridLayout layout(rows, columns, window_width, window_height);
+
+        GameTextureManager::request_assets(layout.get_measurements(), window_width, window_height);
+    }
+
+    /**
+     * Places the mines for the first click. Regular boards only have to clear the mines around it from the prepared
+     * grid. No-guess layouts that aren't pooled are searched in the background, and the game starts from render()
+     * once one is found.
+     */
+    void start_game(const int x, const int y) {
+        if (!m_no_guess) {
+            // Only waits if the click came before the mines were ready
+            m_game.place_grid_mines(x, y, m_prepared_grid.get());
+            m_started_game = true;
+            m_board_outdated = true;
+            reveal_cell(x, y);
+            return;
+        }
+
+        NoGuessPool &pool = NoGuessPool::get_shared();
+        std::optional<std::vector<int>> layout = pool.take(m_game.get_difficulty(), x, y);
+
+        if (layout) {
+            start_game(x, y, *layout);
+            return;
+        }
+
+        m_pending_layout = pool.search(m_game.get_rows(), m_game.get_columns(), m_game.get_total_mines(), x, y);
+        m_pending_click = {x, y, true};
+    }
+
+    void start_game(const int x, const int y, const std::vector<int> &layout) {
+        m_game.place_grid_mines(layout);
+        m_started_game = true;
+        m_board_outdated = true;
+        reveal_cell(x, y);
+    }
+
+    void reveal_cell(const int x, const int y) {
+        const std::vector<Game::GridCoords> &revealed_cells = m_game.reveal_cell(x, y);
+
+        for (const auto &[i, j, inside] : revealed_cells) {
+            update_neighbour_masks(i, j, 1);
+            mark_dirty(i, j, 1);
+        }
+
+        // Losing uncovers every mine
+        if (m_game.is_over() && !m_game.has_won())
+            m_board_outdated = true;
+
+        m_solver.update(revealed_cells);
+        m_probabilities_outdated = true;
+    }
+
+    void toggle_cell_flag(const int x, const int y) {
+        m_game.toggle_cell_flag(x, y);
+        // Flagging around a number changes the neighbours' tiles as well
+        update_neighbour_masks(x, y, 2);
+        mark_dirty(x, y, 2);
+    }
+
+    /**
+     * Cells whose tiles or grid lines might have changed: the cells within radius of (x, y)
+     */
+    void mark_dirty(const int x, const int y, const int radius) {
+        if (m_board_outdated)
+            return;
 
         const int rows = m_game.get_rows();
         const int columns = m_game.get_columns();
 
-        const Game::Measurements &measurements = m_game.get_measurements();
-        const int cell_size = measurements.cell_size;
-        const int grid_x_offset = measurements.grid_x_offset;
-        const int grid_y_offset = measurements.grid_y_offset;
+        for (int j = std::max(y - radius, 0); j <= std::min(y + radius, rows - 1); j++)
+            for (int i = std::max(x - radius, 0); i <= std::min(x + radius, columns - 1); i++)
+                m_dirty_cells.push_back({i, j, true});
+
+        if (m_dirty_cells.size() > MAX_DIRTY_CELLS) {
+            m_board_outdated = true;
+            m_dirty_cells.clear();
+        }
+    }
+
+    /**
+     * The board is kept in its own texture, which only changes where cells did, or as a whole when the view or the
+     * probabilities change
+     */
+    void render_grid() {
+        if (m_board_outdated)
+            redraw_board();
+        else if (!m_dirty_cells.empty())
+            redraw_dirty_cells();
+
+        m_board_outdated = false;
+        m_dirty_cells.clear();
+
+        m_board_texture.render();
+    }
+
+    /**
+     * Only goes over the cells in view, and draws all of them with a single batch
+     */
+    void redraw_board() {
+        SDL_Renderer *renderer = m_engine->get_renderer();
+        const bool show_probabilities = m_started_game && m_show_probabilities && !m_game.is_over();
+        const auto [first_x, first_y, last_x, last_y] = m_camera.get_visible_range();
+
+        const Texture::ScopedRender scoped_render = m_board_texture.set_as_render_target(SDL_BLENDMODE_NONE);
+        Shape::filled_rectangle(renderer, m_board_texture.get_area(), Color::BACKGROUND);
+
+        m_sprite_batch.clear();
+
+        for (int j = first_y; j <= last_y; j++)
+            for (int i = first_x; i <= last_x; i++)
+                add_cell(i, j);
+
+        if (show_probabilities)
+            for (int j = first_y; j <= last_y; j++)
+                for (int i = first_x; i <= last_x; i++)
+                    add_probability(i, j);
+
+        if (m_started_game)
+            for (int j = first_y; j <= last_y; j++)
+                for (int i = first_x; i <= last_x; i++)
+                    add_grid_lines(i, j);
+
+        m_sprite_batch.render();
+    }
+
+    /**
+     * Clipped to each cell, since the grid lines on its edges reach into the neighbours
+     */
+    void redraw_dirty_cells() {
+        SDL_Renderer *renderer = m_engine->get_renderer();
+        const bool show_probabilities = m_started_game && m_show_probabilities && !m_game.is_over();
+        const auto [first_x, first_y, last_x, last_y] = m_camera.get_visible_range();
+
+        const Texture::ScopedRender scoped_render = m_board_texture.set_as_render_target(SDL_BLENDMODE_NONE);
+
+        for (const auto &[i, j, inside] : m_dirty_cells) {
+            if (i < first_x || i > last_x || j < first_y || j > last_y)
+                continue;
 
-        const GameTexture h_grid_line_texture = m_texture_manager.get(TextureName::H_GRID_LINE);
-        const GameTexture v_grid_line_texture = m_texture_manager.get(TextureName::V_GRID_LINE);
+            const SDL_Rect cell_rect = get_cell_rect(i, j);
+            SDL_RenderSetClipRect(renderer, &cell_rect);
+            Shape::filled_rectangle(renderer, cell_rect, Color::BACKGROUND);
 
-        // Render cells
-        for (int i = 0; i < columns; i++) {
-            const int x = grid_x_offset + cell_size * i;
+            m_sprite_batch.clear();
+            add_cell(i, j);
 
-            for (int j = 0; j < rows; j++) {
-                const int y = grid_y_offset + cell_size * j;
-                const Game::GridCell cell = m_game.get_grid_cell(i, j);
+            if (show_probabilities)
+                add_probability(i, j);
 
-                if (cell.type == Game::CELL_0 && cell.revealed)
-                    continue;
+            if (m_started_game) {
+                add_grid_lines(i, j);
 
-                const GameTextureManager::CellType cell_type = get_cell_type(i, j, cell.flagged, cell.revealed);
-                const GameTexture cell_texture = get_grid_cell_texture(cell, cell_type);
+                if (i > 0)
+                    add_grid_lines(i - 1, j);
 
-                cell_texture->render_moved(x, y);
+                if (j > 0)
+                    add_grid_lines(i, j - 1);
             }
+
+            m_sprite_batch.render();
         }
 
-        if (!m_started_game)
-            return;
+        SDL_RenderSetClipRect(renderer, nullptr);
+    }
+
+    [[nodiscard]] SDL_Rect get_cell_rect(const int i, const int j) const {
+        const int x = m_camera.get_cell_x(i);
+        const int y = m_camera.get_cell_y(j);
+
+        return {x, y, m_camera.get_cell_x(i + 1) - x, m_camera.get_cell_y(j + 1) - y};
+    }
 
-        // Render grid
-        for (int i = 0; i < columns; i++) {
-            const int x = grid_x_offset + cell_size * i;
+    void add_cell(const int i, const int j) {
+        const Game::GridCell cell = m_game.get_grid_cell(i, j);
 
-            for (int j = 0; j < rows; j++) {
-                const int y = grid_y_offset + cell_size * j;
-                const Game::GridCell cell = m_game.get_grid_cell(i, j);
+        if (cell.type == Game::CELL_0 && cell.revealed)
+            return;
+
+        const GameTextureManager::CellType cell_type = get_cell_type(i, j, cell.revealed);
+        const Sprite &sprite = get_grid_cell_sprite(cell, cell_type);
+        const SDL_Rect cell_rect = get_cell_rect(i, j);
 
-                if (j != rows - 1) {
-                    const Game::GridCell bottom_cell = m_game.get_grid_cell(i, j + 1);
+        // Numbers only take part of the cell, the rest fill it so neighbours join without seams
+        if (cell.revealed && cell.type != Game::CELL_MINE)
+            m_sprite_batch.add(
+                sprite.source,
+                sprite.get_destination(cell_rect.x, cell_rect.y, static_cast<float>(m_camera.get_zoom()))
+            );
+        else
+            m_sprite_batch.add(sprite.source, make_frect(cell_rect));
+    }
 
-                    if (show_cell_borders || cell.revealed || bottom_cell.revealed
-                        || cell.flagged ^ bottom_cell.flagged)
-                        h_grid_line_texture->render_moved(x, y + cell_size);
-                }
+    /**
+     * Lines below and to the right of the cell
+     */
+    void add_grid_lines(const int i, const int j) {
+        const bool show_cell_borders = Settings::is_on(Settings::SHOW_CELL_BORDERS);
+        const float zoom = static_cast<float>(m_camera.get_zoom());
+        const Game::GridCell cell = m_game.get_grid_cell(i, j);
+
+        if (j != m_game.get_rows() - 1) {
+            const Game::GridCell bottom_cell = m_game.get_grid_cell(i, j + 1);
+
+            if (show_cell_borders || cell.revealed || bottom_cell.revealed || cell.flagged ^ bottom_cell.flagged) {
+                const Sprite &h_grid_line_sprite = m_texture_manager->get(SpriteName::H_GRID_LINE);
+                m_sprite_batch.add(
+                    h_grid_line_sprite.source,
+                    h_grid_line_sprite.get_destination(m_camera.get_cell_x(i), m_camera.get_cell_y(j + 1), zoom)
+                );
+            }
+        }
 
-                if (i != columns - 1) {
-                    const Game::GridCell right_cell = m_game.get_grid_cell(i + 1, j);
+        if (i != m_game.get_columns() - 1) {
+            const Game::GridCell right_cell = m_game.get_grid_cell(i + 1, j);
 
-                    if (show_cell_borders || cell.revealed || right_cell.revealed || cell.flagged ^ right_cell.flagged)
-                        v_grid_line_texture->render_moved(x + cell_size, y);
-                }
+            if (show_cell_borders || cell.revealed || right_cell.revealed || cell.flagged ^ right_cell.flagged) {
+                const Sprite &v_grid_line_sprite = m_texture_manager->get(SpriteName::V_GRID_LINE);
+                m_sprite_batch.add(
+                    v_grid_line_sprite.source,
+                    v_grid_line_sprite.get_destination(m_camera.get_cell_x(i + 1), m_camera.get_cell_y(j), zoom)
+                );
             }
         }
     }
 
+    /**
+     * Tints a covered cell from green to red by its chance of being a mine
+     */
+    void add_probability(const int i, const int j) {
+        const Game::GridCell cell = m_game.get_grid_cell(i, j);
+        if (cell.revealed || cell.flagged)
+            return;
+
+        const float probability = m_probabilities[j * m_game.get_columns() + i];
+        const SDL_Color color = {
+            static_cast<Uint8>(255 * probability),
+            static_cast<Uint8>(255 * (1 - probability)),
+            0,
+            PROBABILITIES_ALPHA,
+        };
+
+        m_sprite_batch.add(m_texture_manager->get(SpriteName::SOLID).source, make_frect(get_cell_rect(i, j)), color);
+    }
+
+    static SDL_FRect make_frect(const SDL_Rect &rect) {
+        return {
+            static_cast<float>(rect.x),
+            static_cast<float>(rect.y),
+            static_cast<float>(rect.w),
+            static_cast<float>(rect.h),
+        };
+    }
+
     static int int_length(int value) {
         int length = 1;
         while (value > 9) {
@@ -306,25 +633,25 @@ private:
     }
 
     void render_remaining_mines() {
-        const GameTexture remaining_mines_text_texture = m_texture_manager.get(TextureName::REMAINING_MINES_TEXT);
+        const GameText remaining_mines_text = m_texture_manager->get(TextName::REMAINING_MINES_TEXT);
         const int current_remaining = m_game.get_remaining_mines();
 
         if (m_remaining_mines != current_remaining) {
             m_remaining_mines = current_remaining;
 
-            remaining_mines_text_texture->update_text(std::to_string(current_remaining));
+            remaining_mines_text->update_text(std::to_string(current_remaining));
 
-            const GameTexture remaining_mines_icon_texture = m_texture_manager.get(TextureName::REMAINING_MINES_ICON);
+            const GameTexture remaining_mines_icon_texture = m_texture_manager->get(TextureName::REMAINING_MINES_ICON);
             const int text_x_offset = remaining_mines_icon_texture->get_w() + 10;
 
             remaining_mines_icon_texture->set_x(
-                (m_window_width - text_x_offset - remaining_mines_text_texture->get_w()) / 2
+                (m_window_width - text_x_offset - remaining_mines_text->get_w()) / 2
             );
-            remaining_mines_text_texture->set_x(remaining_mines_icon_texture->get_x() + text_x_offset);
+            remaining_mines_text->set_x(remaining_mines_icon_texture->get_x() + text_x_offset);
         }
 
-        m_texture_manager.get(TextureName::REMAINING_MINES_ICON)->render();
-        remaining_mines_text_texture->render();
+        m_texture_manager->get(TextureName::REMAINING_MINES_ICON)->render();
+        remaining_mines_text->render();
     }
 
     static std::string get_time_string(const int seconds) {
@@ -344,41 +671,44 @@ private:
     }
 
     void render_game_time() {
-        const GameTexture game_time_text_texture = m_texture_manager.get(TextureName::GAME_TIME_TEXT);
+        const GameText game_time_text = m_texture_manager->get(TextName::GAME_TIME_TEXT);
         const time_t now = time(nullptr);
 
         if (m_last_game_time_rendered == 0 || (!m_game.is_over() && m_last_game_time_rendered < now)) {
             m_last_game_time_rendered = now;
 
             const std::string time_string = get_time_string(now - m_game.get_start_time());
-            game_time_text_texture->update_text(time_string);
-            game_time_text_texture->set_x((m_window_width - game_time_text_texture->get_w()) / 2);
+            game_time_text->update_text(time_string);
+            game_time_text->set_x((m_window_width - game_time_text->get_w()) / 2);
         }
 
-        game_time_text_texture->render();
+        if (!m_game.is_over())
+            m_engine->request_redraw_next_second();
+
+        game_time_text->render();
     }
 
-    [[nodiscard]] GameTexture get_grid_cell_texture(
+    [[nodiscard]] const Sprite &get_grid_cell_sprite(
         const Game::GridCell cell,
         const GameTextureManager::CellType type
     ) const {
         if (m_game.is_over() && !m_game.has_won() && cell.type == Game::CELL_MINE) {
             if (cell.flagged)
-                return m_texture_manager.get(GameTextureManager::CELL_FLAGGED_MINE, type);
+                return m_texture_manager->get(GameTextureManager::CELL_FLAGGED_MINE, type);
 
             if (cell.revealed)
-                return m_texture_manager.get(GameTextureManager::CELL_TRIGGERED_MINE, type);
+                return m_texture_manager->get(GameTextureManager::CELL_TRIGGERED_MINE, type);
 
-            return m_texture_manager.get(GameTextureManager::CELL_COVERED_MINE, type);
+            return m_texture_manager->get(GameTextureManager::CELL_COVERED_MINE, type);
         }
 
         if (cell.flagged)
-            return m_texture_manager.get(GameTextureManager::CELL_FLAG, type);
+            return m_texture_manager->get(GameTextureManager::CELL_FLAG, type);
 
         if (!cell.revealed)
-            return m_texture_manager.get(GameTextureManager::CELL_COVERED, type);
+            return m_texture_manager->get(GameTextureManager::CELL_COVERED, type);
 
-        return m_texture_manager.get(cell.type - Game::CELL_1);
+        return m_texture_manager->get(cell.type - Game::CELL_1);
     }
 
     [[nodiscard]] bool cell_matches_type(const int x, const int y, const bool flagged) const {
@@ -386,24 +716,6 @@ private:
         return !revealed && flagged == cell_flagged;
     }
 
-    static bool exclusively_has_corners(const int corners, const int required_corners) {
-        const bool bits_outside_of_mask = corners & ~required_corners;
-        const bool bits_in_mask = corners & required_corners;
-        return !bits_outside_of_mask && bits_in_mask;
-    }
-
-    static int has_single_corner(const int x) {
-        return x > 0 && !(x & x - 1);
-    }
-
-    static int obtain_single_corner(int x) {
-        int log2 = 0;
-        while (x >>= 1)
-            log2++;
-
-        return log2;
-    }
-
     static constexpr GameTextureManager::CellType TEXTURE_CELL_SIDE_TYPE_ORDER[16] = {
         GameTextureManager::CELL_NO_SIDES,
         GameTextureManager::CELL_R,
@@ -461,52 +773,86 @@ private:
         GameTextureManager::CELL_TLC,
     };
 
-    [[nodiscard]] GameTextureManager::CellType get_cell_type(
-        const int x,
-        const int y,
-        const bool flagged,
-        const bool revealed
-    ) const {
-        if (revealed)
-            return GameTextureManager::CELL_NO_SIDES;
+    /**
+     * Tile of a covered cell by its neighbours mask, see get_neighbour_mask(). Corners only count when both sides
+     * next to them do.
+     */
+    static constexpr std::array<GameTextureManager::CellType, 256> CELL_TYPES_BY_MASK = [] {
+        std::array<GameTextureManager::CellType, 256> cell_types{};
+
+        for (int mask = 0; mask < 256; mask++) {
+            const bool T = mask & 1 << 1;
+            const bool B = mask & 1 << 6;
+            const bool L = mask & 1 << 3;
+            const bool R = mask & 1 << 4;
+            const bool TLC = T && L && mask & 1 << 0;
+            const bool TRC = T && R && mask & 1 << 2;
+            const bool BLC = B && L && mask & 1 << 5;
+            const bool BRC = B && R && mask & 1 << 7;
+
+            const int TBLR = T << 3 | B << 2 | L << 1 | R;
+            const int TLR_BLR_C = TLC << 3 | TRC << 2 | BLC << 1 | BRC;
+
+            if (TLR_BLR_C == 0b0000)
+                cell_types[mask] = TEXTURE_CELL_SIDE_TYPE_ORDER[TBLR];
+            else if (TBLR == 0b1111)
+                cell_types[mask] = TEXTURE_CELL_CORNER_TYPE_ORDER[TLR_BLR_C - 1];
+            // With three sides, the corners can only be the two between them
+            else if (TBLR == 0b0111)
+                cell_types[mask] = TEXTURE_CELL_CORNER_TYPE_ORDER[TLR_BLR_C + 14];
+            else if (TBLR == 0b1011)
+                cell_types[mask] = TEXTURE_CELL_CORNER_TYPE_ORDER[TLR_BLR_C + 15];
+            else if (TBLR == 0b1101)
+                cell_types[mask] = TEXTURE_CELL_CORNER_TYPE_ORDER[TLR_BLR_C + 17];
+            else if (TBLR == 0b1110)
+                cell_types[mask] = TEXTURE_CELL_CORNER_TYPE_ORDER[TLR_BLR_C + 18];
+            // With two sides, a single corner
+            else
+                cell_types[mask] = TEXTURE_CELL_CORNER_TYPE_ORDER[(TLC ? 3 : TRC ? 2 : BLC ? 1 : 0) + 29];
+        }
 
-        const int rows = m_game.get_rows();
-        const int columns = m_game.get_columns();
+        return cell_types;
+    }();
 
-        const bool T = y - 1 >= 0 && cell_matches_type(x, y - 1, flagged);
-        const bool B = y + 1 <= rows - 1 && cell_matches_type(x, y + 1, flagged);
-        const bool L = x - 1 >= 0 && cell_matches_type(x - 1, y, flagged);
-        const bool R = x + 1 <= columns - 1 && cell_matches_type(x + 1, y, flagged);
-        const bool TLC = T && L && cell_matches_type(x - 1, y - 1, flagged);
-        const bool TRC = T && R && cell_matches_type(x + 1, y - 1, flagged);
-        const bool BLC = B && L && cell_matches_type(x - 1, y + 1, flagged);
-        const bool BRC = B && R && cell_matches_type(x + 1, y + 1, flagged);
+    /**
+     * Bit i is set if the i-th neighbour, in Game's neighbour order, is covered and flagged like the cell
+     */
+    [[nodiscard]] uint8_t get_neighbour_mask(const int x, const int y) const {
+        static constexpr int NEIGHBOUR_DX[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+        static constexpr int NEIGHBOUR_DY[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
 
-        const int TBLR = T << 3 | B << 2 | L << 1 | R;
-        const int TLR_BLR_C = TLC << 3 | TRC << 2 | BLC << 1 | BRC;
+        const bool flagged = m_game.get_grid_cell(x, y).flagged;
+        uint8_t mask = 0;
 
-        if (TLR_BLR_C == 0b0000)
-            return TEXTURE_CELL_SIDE_TYPE_ORDER[TBLR];
+        // Cells outside the grid are revealed sentinels, so they never match
+        for (int i = 0; i < 8; i++)
+            mask |= cell_matches_type(x + NEIGHBOUR_DX[i], y + NEIGHBOUR_DY[i], flagged) << i;
 
-        if (TBLR == 0b1111)
-            return TEXTURE_CELL_CORNER_TYPE_ORDER[TLR_BLR_C - 1];
+        return mask;
+    }
 
-        if (TBLR == 0b0111 && exclusively_has_corners(TLR_BLR_C, 0b0011))
-            return TEXTURE_CELL_CORNER_TYPE_ORDER[TLR_BLR_C + 14];
-        if (TBLR == 0b1011 && exclusively_has_corners(TLR_BLR_C, 0b1100))
-            return TEXTURE_CELL_CORNER_TYPE_ORDER[TLR_BLR_C + 15];
-        if (TBLR == 0b1101 && exclusively_has_corners(TLR_BLR_C, 0b0101))
-            return TEXTURE_CELL_CORNER_TYPE_ORDER[TLR_BLR_C + 17];
-        if (TBLR == 0b1110 && exclusively_has_corners(TLR_BLR_C, 0b1010))
-            return TEXTURE_CELL_CORNER_TYPE_ORDER[TLR_BLR_C + 18];
+    void update_neighbour_masks() {
+        for (int y = 0; y < m_game.get_rows(); y++)
+            for (int x = 0; x < m_game.get_columns(); x++)
+                m_neighbour_masks[y * m_game.get_columns() + x] = get_neighbour_mask(x, y);
+    }
 
-        if (has_single_corner(TLR_BLR_C))
-            return TEXTURE_CELL_CORNER_TYPE_ORDER[obtain_single_corner(TLR_BLR_C) + 29];
+    /**
+     * Only the cells within radius of (x, y)
+     */
+    void update_neighbour_masks(const int x, const int y, const int radius) {
+        const int columns = m_game.get_columns();
 
-        // Impossible to reach? Not reached in huge grid
-        std::cerr << "Not impossible to reach" << std::endl;
+        for (int j = std::max(y - radius, 0); j <= std::min(y + radius, m_game.get_rows() - 1); j++)
+            for (int i = std::max(x - radius, 0); i <= std::min(x + radius, columns - 1); i++)
+                m_neighbour_masks[j * columns + i] = get_neighbour_mask(i, j);
+    }
+
+    [[nodiscard]] GameTextureManager::CellType get_cell_type(const int x, const int y, const bool revealed) const {
+        if (revealed)
+            return GameTextureManager::CELL_NO_SIDES;
 
-        return GameTextureManager::CELL_NO_SIDES;
+        return CELL_TYPES_BY_MASK[m_neighbour_masks[y * m_game.get_columns() + x]];
     }
 };
 
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+
+#include "screen.hpp"
+#include "../core/infinite_game.hpp"
+#include "../core/settings.hpp"
+#include "../graphics/grid_layout.hpp"
+#include "../graphics/sprite_batch.hpp"
+#include "../texture_managers/game_texture_manager.hpp"
+
+class Engine;
+class MainMenuScreen;
+
+/**
+ * Board with no edges. Drag with any mouse button or use the arrow keys to move around, only the cells in view are
+ * ever generated or drawn.
+ */
+class InfiniteGameScreen final : virtual public Screen {
+    using GameTexture = GameTextureManager::GameTexture;
+    using GameText = GameTextureManager::GameText;
+    using Sprite = GameTextureManager::Sprite;
+    using TextName = GameTextureManager::TextName;
+    using TextureName = GameTextureManager::TextureName;
+    using TextureBundleName = GameTextureManager::TextureBundleName;
+
+    static constexpr int CELLS_PER_WINDOW_HEIGHT = 24;
+    // Pixels the cursor can move while pressed before it counts as a drag instead of a click
+    static constexpr int DRAG_THRESHOLD = 8;
+    // Chunks kept around the view besides the ones in it, so turning back doesn't regenerate them
+    static constexpr int TRIM_MARGIN = 2;
+
+    Engine *m_engine;
+    int m_window_width;
+    int m_window_height;
+    InfiniteGame m_game;
+    GridLayout::Measurements m_measurements;
+    std::shared_ptr<GameTextureManager> m_texture_manager;
+    SpriteBatch m_sprite_batch;
+    // Board pixel at the top left corner of the window
+    double m_camera_x;
+    double m_camera_y;
+    Uint8 m_pressed_button = 0;
+    int m_drag_distance = 0;
+    int m_trim_radius;
+    int m_last_trim_x = 0;
+    int m_last_trim_y = 0;
+    time_t m_last_game_time_rendered = 0;
+    int64_t m_flagged_count = -1;
+
+    SDL_Cursor *const m_arrow_cursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_ARROW);
+    SDL_Cursor *const m_hand_cursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_HAND);
+
+public:
+    explicit InfiniteGameScreen(Engine *engine) :
+        m_engine(engine),
+        m_window_width(engine->get_window_width()),
+        m_window_height(engine->get_window_height()),
+        m_measurements(calculate_measurements(m_window_height)),
+        m_texture_manager(engine->get_resource_cache().get<GameTextureManager>(
+            GameTextureManager::make_cache_key(m_measurements, Game::DIFFIC_CUSTOM, m_window_width, m_window_height),
+            engine->get_renderer(),
+            m_measurements,
+            Game::DIFFIC_CUSTOM,
+            m_window_width,
+            m_window_height
+        )),
+        m_sprite_batch(engine->get_renderer(), m_texture_manager->get_atlas()),
+        m_camera_x(-m_window_width / 2.0),
+        m_camera_y(-m_window_height / 2.0),
+        m_trim_radius(
+            (std::max(m_window_width, m_window_height) / m_measurements.cell_size) / InfiniteGame::CHUNK_SIZE / 2
+            + 1 + TRIM_MARGIN
+        ) {}
+
+    ~InfiniteGameScreen() override = default;
+
+    /**
+     * Called with the constructor's arguments before making the screen, see Engine::set_screen()
+     */
+    static void request_assets(Engine *engine) {
+        GameTextureManager::request_assets(
+            calculate_measurements(engine->get_window_height()),
+            engine->get_window_width(),
+            engine->get_window_height()
+        );
+    }
+
+    void before_event(const SDL_Event &event) override {}
+
+    void on_keyboard_event(const SDL_KeyboardEvent &event) override {
+        if (event.type != SDL_KEYDOWN)
+            return;
+
+        const int cell_size = m_measurements.cell_size;
+
+        switch (event.keysym.sym) {
+            case SDLK_ESCAPE:
+                m_engine->set_screen<MainMenuScreen>(m_engine);
+                return;
+            case SDLK_LEFT:
+                m_camera_x -= cell_size;
+                return;
+            case SDLK_RIGHT:
+                m_camera_x += cell_size;
+                return;
+            case SDLK_UP:
+                m_camera_y -= cell_size;
+                return;
+            case SDLK_DOWN:
+                m_camera_y += cell_size;
+                return;
+            default:
+                return;
+        }
+    }
+
+    /**
+     * Cells are only played when the button is released without dragging
+     */
+    void on_mouse_button_event(const SDL_MouseButtonEvent &event) override {
+        SDL_Point cursor_pos;
+        SDL_GetMouseState(&cursor_pos.x, &cursor_pos.y);
+
+        if (event.type == SDL_MOUSEBUTTONDOWN) {
+            if (event.button == SDL_BUTTON_LEFT
+                && m_texture_manager->get(TextureName::BACK_BUTTON)->contains(cursor_pos)) {
+                m_engine->set_screen<MainMenuScreen>(m_engine);
+                return;
+            }
+
+            m_pressed_button = event.button;
+            m_drag_distance = 0;
+            return;
+        }
+
+        if (event.type != SDL_MOUSEBUTTONUP || event.button != m_pressed_button)
+            return;
+
+        m_pressed_button = 0;
+
+        if (m_drag_distance > DRAG_THRESHOLD || m_game.is_over()
+            || (event.button != SDL_BUTTON_LEFT && event.button != SDL_BUTTON_RIGHT))
+            return;
+
+        const bool swapped_controls = Settings::is_on(Settings::SWAP_CONTROLS);
+        const bool left_click = event.button == (swapped_controls ? SDL_BUTTON_RIGHT : SDL_BUTTON_LEFT);
+        const int x = board_coord(m_camera_x + cursor_pos.x);
+        const int y = board_coord(m_camera_y + cursor_pos.y);
+
+        if (left_click) {
+            m_game.reveal_cell(x, y);
+            return;
+        }
+
+        if (m_game.has_started())
+            m_game.toggle_cell_flag(x, y);
+    }
+
+    void on_mouse_motion_event(const SDL_MouseMotionEvent &event) override {
+        SDL_Point cursor_pos;
+        SDL_GetMouseState(&cursor_pos.x, &cursor_pos.y);
+
+        if (m_pressed_button != 0) {
+            m_drag_distance += std::abs(event.xrel) + std::abs(event.yrel);
+
+            if (m_drag_distance > DRAG_THRESHOLD) {
+                m_camera_x -= event.xrel;
+                m_camera_y -= event.yrel;
+            }
+        }
+
+        SDL_SetCursor(
+            m_texture_manager->get(TextureName::BACK_BUTTON)->contains(cursor_pos) ? m_hand_cursor : m_arrow_cursor
+        );
+    }
+
+    void on_mouse_wheel_event(const SDL_MouseWheelEvent &event) override {}
+
+    void on_quit_event(const SDL_QuitEvent &event) override {}
+
+    void render() override {
+        if (m_game.is_revealing()) {
+            m_game.continue_reveal();
+
+            if (m_game.is_revealing())
+                m_engine->request_redraw();
+        }
+
+        render_grid();
+        trim_chunks();
+        render_flagged_count();
+
+        if (m_game.has_started())
+            render_game_time();
+
+        m_texture_manager->get(TextureName::BACK_BUTTON)->render();
+
+        if (!m_game.has_started())
+            m_texture_manager->get(TextureName::CLICK_TO_START)->render();
+
+        if (m_game.is_over())
+            m_texture_manager->get(TextureBundleName::GAME_LOST)->render();
+    }
+
+private:
+    static GridLayout::Measurements calculate_measurements(const int window_height) {
+        const int cell_size = lround(static_cast<double>(window_height) / CELLS_PER_WINDOW_HEIGHT);
+
+        return {
+            cell_size,
+            static_cast<int>(cell_size * 0.65),
+            static_cast<int>(lround(cell_size * 0.03)),
+        };
+    }
+
+    [[nodiscard]] int board_coord(const double pixel) const {
+        return static_cast<int>(std::floor(pixel / m_measurements.cell_size));
+    }
+
+    void render_grid() {
+        const int cell_size = m_measurements.cell_size;
+        const int first_x = board_coord(m_camera_x);
+        const int first_y = board_coord(m_camera_y);
+        const int last_x = board_coord(m_camera_x + m_window_width - 1);
+        const int last_y = board_coord(m_camera_y + m_window_height - 1);
+
+        m_sprite_batch.clear();
+
+        for (int j = first_y; j <= last_y; j++) {
+            const int y = static_cast<int>(std::floor(static_cast<double>(j) * cell_size - m_camera_y));
+
+            for (int i = first_x; i <= last_x; i++) {
+                const int x = static_cast<int>(std::floor(static_cast<double>(i) * cell_size - m_camera_x));
+                const InfiniteGame::GridCell cell = m_game.get_grid_cell(i, j);
+
+                if (cell.type == Game::CELL_0 && cell.revealed)
+                    continue;
+
+                const Sprite &sprite = get_grid_cell_sprite(cell);
+                m_sprite_batch.add(sprite.source, sprite.get_destination(x, y, 1));
+            }
+        }
+
+        m_sprite_batch.render();
+    }
+
+    /**
+     * Only once the view moves to another chunk, since it has to go over every chunk
+     */
+    void trim_chunks() {
+        const int center_x = board_coord(m_camera_x + m_window_width / 2.0);
+        const int center_y = board_coord(m_camera_y + m_window_height / 2.0);
+
+        if (InfiniteGame::chunk_coord(center_x) == InfiniteGame::chunk_coord(m_last_trim_x)
+            && InfiniteGame::chunk_coord(center_y) == InfiniteGame::chunk_coord(m_last_trim_y))
+            return;
+
+        m_last_trim_x = center_x;
+        m_last_trim_y = center_y;
+        m_game.trim(center_x, center_y, m_trim_radius);
+    }
+
+    void render_flagged_count() {
+        const GameText flagged_text = m_texture_manager->get(TextName::REMAINING_MINES_TEXT);
+        const int64_t flagged_count = m_game.get_flagged_count();
+
+        if (m_flagged_count != flagged_count) {
+            m_flagged_count = flagged_count;
+
+            flagged_text->update_text(std::to_string(flagged_count));
+
+            const GameTexture mine_icon_texture = m_texture_manager->get(TextureName::REMAINING_MINES_ICON);
+            const int text_x_offset = mine_icon_texture->get_w() + 10;
+
+            mine_icon_texture->set_x((m_window_width - text_x_offset - flagged_text->get_w()) / 2);
+            flagged_text->set_x(mine_icon_texture->get_x() + text_x_offset);
+        }
+
+        m_texture_manager->get(TextureName::REMAINING_MINES_ICON)->render();
+        flagged_text->render();
+    }
+
+    void render_game_time() {
+        const GameText game_time_text = m_texture_manager->get(TextName::GAME_TIME_TEXT);
+        const time_t now = time(nullptr);
+
+        if (m_last_game_time_rendered == 0 || (!m_game.is_over() && m_last_game_time_rendered < now)) {
+            m_last_game_time_rendered = now;
+
+            const int seconds = static_cast<int>(now - m_game.get_start_time());
+            std::string time_string;
+
+            if (seconds >= 60)
+                time_string += std::to_string(seconds / 60) + "M ";
+
+            time_string += std::to_string(seconds % 60) + "S";
+
+            game_time_text->update_text(time_string);
+            game_time_text->set_x((m_window_width - game_time_text->get_w()) / 2);
+        }
+
+        if (!m_game.is_over())
+            m_engine->request_redraw_next_second();
+
+        game_time_text->render();
+    }
+
+    [[nodiscard]] const Sprite &get_grid_cell_sprite(const InfiniteGame::GridCell cell) const {
+        constexpr GameTextureManager::CellType type = GameTextureManager::CELL_NO_SIDES;
+
+        if (m_game.is_over() && cell.type == Game::CELL_MINE) {
+            if (cell.flagged)
+                return m_texture_manager->get(GameTextureManager::CELL_FLAGGED_MINE, type);
+
+            if (cell.revealed)
+                return m_texture_manager->get(GameTextureManager::CELL_TRIGGERED_MINE, type);
+
+            return m_texture_manager->get(GameTextureManager::CELL_COVERED_MINE, type);
+        }
+
+        if (cell.flagged)
+            return m_texture_manager->get(GameTextureManager::CELL_FLAG, type);
+
+        if (!cell.revealed)
+            return m_texture_manager->get(GameTextureManager::CELL_COVERED, type);
+
+        return m_texture_manager->get(cell.type - Game::CELL_1);
+    }
+};
@@ -3,8 +3,10 @@
 #include <SDL.h>
 
 #include "game_screen.hpp"
+#include "infinite_game_screen.hpp"
 #include "screen.hpp"
 #include "settings_screen.hpp"
+#include "../core/no_guess_pool.hpp"
 #include "../texture_managers/main_menu_texture_manager.hpp"
 
 class Engine;
@@ -15,9 +17,10 @@ class MainMenuScreen final : virtual public Screen {
     Engine *m_engine;
     int m_window_width;
     int m_window_height;
-    MainMenuTextureManager m_texture_manager;
+    std::shared_ptr<MainMenuTextureManager> m_texture_manager;
 
     static Game::Difficulty selected_difficulty;
+    static bool no_guess;
 
     SDL_Cursor *const m_arrow_cursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_ARROW);
     SDL_Cursor *const m_hand_cursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_HAND);
@@ -27,10 +30,22 @@ public:
         m_engine(engine),
         m_window_width(engine->get_window_width()),
         m_window_height(engine->get_window_height()),
-        m_texture_manager(engine->get_renderer(), m_window_width, m_window_height) {}
+        m_texture_manager(engine->get_resource_cache().get<MainMenuTextureManager>(
+            MainMenuTextureManager::make_cache_key(m_window_width, m_window_height),
+            engine->get_renderer(),
+            m_window_width,
+            m_window_height
+        )) {}
 
     ~MainMenuScreen() override = default;
 
+    /**
+     * Called with the constructor's arguments before making the screen, see Engine::set_screen()
+     */
+    static void request_assets(Engine *engine) {
+        MainMenuTextureManager::request_assets(engine->get_window_height());
+    }
+
     void before_event(const SDL_Event &event) override {}
 
     void on_keyboard_event(const SDL_KeyboardEvent &event) override {
@@ -48,22 +63,27 @@ public:
         SDL_Point cursor_pos;
         SDL_GetMouseState(&cursor_pos.x, &cursor_pos.y);
 
-        const bool cursor_in_quit_button = m_texture_manager.get(TextureName::QUIT_BUTTON)->contains(cursor_pos);
+        const bool cursor_in_quit_button = m_texture_manager->get(TextureName::QUIT_BUTTON)->contains(cursor_pos);
 
-        const bool cursor_in_settings_button = m_texture_manager.get(TextureName::SETTINGS_BUTTON)
+        const bool cursor_in_settings_button = m_texture_manager->get(TextureName::SETTINGS_BUTTON)
                                                                ->contains(cursor_pos);
 
-        const bool cursor_in_new_game_button = m_texture_manager.get(TextureName::NEW_GAME_BUTTON)
+        const bool cursor_in_new_game_button = m_texture_manager->get(TextureName::NEW_GAME_BUTTON)
                                                                ->contains(cursor_pos);
 
         const bool cursor_in_continue_button = Game::save_exists(selected_difficulty)
-                && m_texture_manager.get(TextureName::CONTINUE_GAME_BUTTON)->contains(cursor_pos);
+                && m_texture_manager->get(TextureName::CONTINUE_GAME_BUTTON)->contains(cursor_pos);
+
+        const bool cursor_in_no_guess_toggle = m_texture_manager->get(get_no_guess_toggle_name())->contains(cursor_pos);
+
+        const bool cursor_in_infinite_button = m_texture_manager->get(TextureName::INFINITE_BUTTON)
+                                                               ->contains(cursor_pos);
 
         const bool cursor_in_left_arrow = selected_difficulty != Game::DIFFIC_LOWEST
-                && m_texture_manager.get(TextureName::LEFT_ARROW)->contains(cursor_pos);
+                && m_texture_manager->get(TextureName::LEFT_ARROW)->contains(cursor_pos);
 
         const bool cursor_in_right_arrow = selected_difficulty != Game::DIFFIC_HIGHEST
-                && m_texture_manager.get(TextureName::RIGHT_ARROW)->contains(cursor_pos);
+                && m_texture_manager->get(TextureName::RIGHT_ARROW)->contains(cursor_pos);
 
         if (cursor_in_quit_button) {
             SDL_Event quit_event = {.type = SDL_QUIT};
@@ -77,7 +97,7 @@ public:
         }
 
         if (cursor_in_new_game_button) {
-            m_engine->set_screen<GameScreen>(m_engine, selected_difficulty);
+            m_engine->set_screen<GameScreen>(m_engine, selected_difficulty, no_guess);
             return;
         }
 
@@ -86,8 +106,20 @@ public:
             return;
         }
 
+        if (cursor_in_infinite_button) {
+            m_engine->set_screen<InfiniteGameScreen>(m_engine);
+            return;
+        }
+
+        if (cursor_in_no_guess_toggle) {
+            no_guess = !no_guess;
+            prefill_no_guess_layouts();
+            return;
+        }
+
         if (cursor_in_left_arrow) {
             selected_difficulty = static_cast<Game::Difficulty>(selected_difficulty - 1);
+            prefill_no_guess_layouts();
             if (selected_difficulty == Game::DIFFIC_LOWEST)
                 SDL_SetCursor(m_arrow_cursor);
             return;
@@ -95,6 +127,7 @@ public:
 
         if (cursor_in_right_arrow) {
             selected_difficulty = static_cast<Game::Difficulty>(selected_difficulty + 1);
+            prefill_no_guess_layouts();
             if (selected_difficulty == Game::DIFFIC_HIGHEST)
                 SDL_SetCursor(m_arrow_cursor);
             return;
@@ -105,28 +138,35 @@ public:
         SDL_Point cursor_pos;
         SDL_GetMouseState(&cursor_pos.x, &cursor_pos.y);
 
-        const bool cursor_in_quit_button = m_texture_manager.get(TextureName::QUIT_BUTTON)->contains(cursor_pos);
+        const bool cursor_in_quit_button = m_texture_manager->get(TextureName::QUIT_BUTTON)->contains(cursor_pos);
 
-        const bool cursor_in_settings_button = m_texture_manager.get(TextureName::SETTINGS_BUTTON)
+        const bool cursor_in_settings_button = m_texture_manager->get(TextureName::SETTINGS_BUTTON)
                                                                ->contains(cursor_pos);
 
-        const bool cursor_in_new_game_button = m_texture_manager.get(TextureName::NEW_GAME_BUTTON)
+        const bool cursor_in_new_game_button = m_texture_manager->get(TextureName::NEW_GAME_BUTTON)
                                                                ->contains(cursor_pos);
 
         const bool cursor_in_continue_button = Game::save_exists(selected_difficulty)
-                && m_texture_manager.get(TextureName::CONTINUE_GAME_BUTTON)->contains(cursor_pos);
+                && m_texture_manager->get(TextureName::CONTINUE_GAME_BUTTON)->contains(cursor_pos);
+
+        const bool cursor_in_no_guess_toggle = m_texture_manager->get(get_no_guess_toggle_name())->contains(cursor_pos);
+
+        const bool cursor_in_infinite_button = m_texture_manager->get(TextureName::INFINITE_BUTTON)
+                                                               ->contains(cursor_pos);
 
         const bool cursor_in_left_arrow = selected_difficulty != Game::DIFFIC_LOWEST
-                && m_texture_manager.get(TextureName::LEFT_ARROW)->contains(cursor_pos);
+                && m_texture_manager->get(TextureName::LEFT_ARROW)->contains(cursor_pos);
 
         const bool cursor_in_right_arrow = selected_difficulty != Game::DIFFIC_HIGHEST
-                && m_texture_manager.get(TextureName::RIGHT_ARROW)->contains(cursor_pos);
+                && m_texture_manager->get(TextureName::RIGHT_ARROW)->contains(cursor_pos);
 
         SDL_SetCursor(
             cursor_in_quit_button
             || cursor_in_settings_button
             || cursor_in_new_game_button
             || cursor_in_continue_button
+            || cursor_in_no_guess_toggle
+            || cursor_in_infinite_button
             || cursor_in_left_arrow
             || cursor_in_right_arrow
             ? m_hand_cursor
@@ -139,24 +179,41 @@ public:
     void on_quit_event(const SDL_QuitEvent &event) override {}
 
     void render() override {
-        m_texture_manager.get(TextureName::BIG_MINE)->render();
-        m_texture_manager.get(TextureName::TITLE)->render();
-        m_texture_manager.get(TextureName::QUIT_BUTTON)->render();
-        m_texture_manager.get(TextureName::NEW_GAME_BUTTON)->render();
+        m_texture_manager->get(TextureName::BIG_MINE)->render();
+        m_texture_manager->get(TextureName::TITLE)->render();
+        m_texture_manager->get(TextureName::QUIT_BUTTON)->render();
+        m_texture_manager->get(TextureName::NEW_GAME_BUTTON)->render();
 
         if (Game::save_exists(selected_difficulty))
-            m_texture_manager.get(TextureName::CONTINUE_GAME_BUTTON)->render();
+            m_texture_manager->get(TextureName::CONTINUE_GAME_BUTTON)->render();
+
+        m_texture_manager->get(get_no_guess_toggle_name())->render();
+        m_texture_manager->get(TextureName::INFINITE_BUTTON)->render();
 
         if (selected_difficulty != Game::DIFFIC_LOWEST)
-            m_texture_manager.get(TextureName::LEFT_ARROW)->render();
+            m_texture_manager->get(TextureName::LEFT_ARROW)->render();
 
         if (selected_difficulty != Game::DIFFIC_HIGHEST)
-            m_texture_manager.get(TextureName::RIGHT_ARROW)->render();
+            m_texture_manager->get(TextureName::RIGHT_ARROW)->render();
 
-        m_texture_manager.get(selected_difficulty)->render();
+        m_texture_manager->get(selected_difficulty)->render();
+
+        m_texture_manager->get(MainMenuTextureManager::SETTINGS_BUTTON)->render();
+    }
+
+private:
+    static TextureName get_no_guess_toggle_name() {
+        return no_guess ? TextureName::NO_GUESS_ON_TOGGLE : TextureName::NO_GUESS_OFF_TOGGLE;
+    }
 
-        m_texture_manager.get(MainMenuTextureManager::SETTINGS_BUTTON)->render();
+    /**
+     * Gets no-guess layouts of the selected difficulty ready while the player is still in the menu
+     */
+    static void prefill_no_guess_layouts() {
+        if (no_guess)
+            NoGuessPool::get_shared().prefill(selected_difficulty);
     }
 };
 
 Game::Difficulty MainMenuScreen::selected_difficulty = Game::DIFFIC_LOWEST;
+bool MainMenuScreen::no_guess = false;
@@ -19,7 +19,7 @@ class SettingsScreen final : virtual public Screen {
     Engine *m_engine;
     int m_window_width;
     int m_window_height;
-    SettingsTextureManager m_texture_manager;
+    std::shared_ptr<SettingsTextureManager> m_texture_manager;
     int m_scroll_step;
     int m_max_scroll;
     int m_scrollbar_max_y;
@@ -36,14 +36,24 @@ public:
         m_engine(engine),
         m_window_width(engine->get_window_width()),
         m_window_height(engine->get_window_height()),
-        m_texture_manager(engine->get_renderer(), m_window_width, m_window_height),
+        m_texture_manager(engine->get_resource_cache().get<SettingsTextureManager>(
+            SettingsTextureManager::make_cache_key(m_window_width, m_window_height),
+            engine->get_renderer(),
+            m_window_width,
+            m_window_height
+        )),
         m_scroll_step(m_window_width * 0.03),
-        m_max_scroll(m_window_height / 2 - m_texture_manager.get_settings_total_height()),
-        m_scrollbar_max_y(m_window_height - m_texture_manager.get(TextureName::SCROLLBAR)->get_h()),
+        m_max_scroll(m_window_height / 2 - m_texture_manager->get_settings_total_height()),
+        m_scrollbar_max_y(m_window_height - m_texture_manager->get(TextureName::SCROLLBAR)->get_h()),
         m_scrollbar_step(m_scrollbar_max_y / (-m_max_scroll / m_scroll_step)) {}
 
     ~SettingsScreen() override = default;
 
+    /**
+     * Only uses fonts, which are loaded by then
+     */
+    static void request_assets(Engine *) {}
+
     void before_event(const SDL_Event &event) override {}
 
     void on_keyboard_event(const SDL_KeyboardEvent &event) override {
@@ -63,8 +73,8 @@ public:
 
         Settings::Name selected_setting;
 
-        const bool cursor_in_back_button = m_texture_manager.get(TextureName::BACK_BUTTON)->contains(cursor_pos);
-        const bool cursor_in_scrollbar = m_texture_manager.get(TextureName::SCROLLBAR)->contains(cursor_pos);
+        const bool cursor_in_back_button = m_texture_manager->get(TextureName::BACK_BUTTON)->contains(cursor_pos);
+        const bool cursor_in_scrollbar = m_texture_manager->get(TextureName::SCROLLBAR)->contains(cursor_pos);
         const bool cursor_in_setting_toggle = mouse_on_setting_toggle(cursor_pos, &selected_setting);
 
         if (event.type == SDL_MOUSEBUTTONDOWN && event.button == SDL_BUTTON_LEFT && cursor_in_scrollbar) {
@@ -91,8 +101,8 @@ public:
         SDL_Point cursor_pos;
         SDL_GetMouseState(&cursor_pos.x, &cursor_pos.y);
 
-        const bool cursor_in_back_button = m_texture_manager.get(TextureName::BACK_BUTTON)->contains(cursor_pos);
-        const bool cursor_in_scrollbar = m_texture_manager.get(TextureName::SCROLLBAR)->contains(cursor_pos);
+        const bool cursor_in_back_button = m_texture_manager->get(TextureName::BACK_BUTTON)->contains(cursor_pos);
+        const bool cursor_in_scrollbar = m_texture_manager->get(TextureName::SCROLLBAR)->contains(cursor_pos);
         const bool cursor_in_setting_toggle = mouse_on_setting_toggle(cursor_pos);
 
         SDL_SetCursor(
@@ -144,8 +154,8 @@ public:
     void on_quit_event(const SDL_QuitEvent &event) override {}
 
     void render() override {
-        m_texture_manager.get(TextureName::BACK_BUTTON)->render();
-        m_texture_manager.get(TextureName::SCROLLBAR)->render_moved(0, m_scrollbar_y);
+        m_texture_manager->get(TextureName::BACK_BUTTON)->render();
+        m_texture_manager->get(TextureName::SCROLLBAR)->render_moved(0, m_scrollbar_y);
 
         for (int bundle_name = 0; bundle_name < SETTINGS_AMOUNT; ++bundle_name)
             render_setting(static_cast<TextureBundleName>(bundle_name));
@@ -153,9 +163,9 @@ public:
 
 private:
     void render_setting(const TextureBundleName bundle_name) const {
-        const SettingsTextureBundle texture_bundle = m_texture_manager.get(bundle_name);
-        const SettingsTexture toggle_on_texture = m_texture_manager.get(TextureName::TOGGLE_ON);
-        const SettingsTexture toggle_off_texture = m_texture_manager.get(TextureName::TOGGLE_OFF);
+        const SettingsTextureBundle texture_bundle = m_texture_manager->get(bundle_name);
+        const SettingsTexture toggle_on_texture = m_texture_manager->get(TextureName::TOGGLE_ON);
+        const SettingsTexture toggle_off_texture = m_texture_manager->get(TextureName::TOGGLE_OFF);
         const int toggle_y = Font::get_shared(Font::SECONDARY)->get_size()
                 + texture_bundle->get_y()
                 + texture_bundle->get_h()
@@ -182,10 +192,10 @@ private:
     ) const {
         // TODO is std::any_of better? (clang suggestion)
         for (int bundle_name = 0; bundle_name < SETTINGS_AMOUNT; ++bundle_name) {
-            const SettingsTextureBundle texture_bundle = m_texture_manager.get(
+            const SettingsTextureBundle texture_bundle = m_texture_manager->get(
                 static_cast<TextureBundleName>(bundle_name)
             );
-            const SettingsTexture toggle_texture = m_texture_manager.get(TextureName::TOGGLE_ON);
+            const SettingsTexture toggle_texture = m_texture_manager->get(TextureName::TOGGLE_ON);
 
             const int toggle_y = Font::get_shared(Font::SECONDARY)->get_size()
                     + texture_bundle->get_y()
@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "simulator.hpp"
+#include "strategy.hpp"
+#include "../core/game.hpp"
+#include "../core/random.hpp"
+#include "../core/work_stealing_pool.hpp"
+
+struct Options {
+    int games = 1000;
+    unsigned threads = WorkStealingPool::default_threads();
+    uint64_t seed = CounterRandom::make_seed();
+    std::string strategy = "solver";
+    std::vector<Simulator::Board> boards{};
+};
+
+static constexpr auto USAGE = R"(Usage: minesweeper_sim [options]
+
+Plays games without rendering them and reports the results of every board.
+
+Options:
+  -n, --games <count>          Games per board (default 1000)
+  -d, --difficulty <name|all>  Board of a difficulty, can be repeated (default all)
+  -c, --custom <RxCxM>         Board of R rows, C columns and M mines, can be repeated
+  -s, --strategy <name>        Strategy playing the games: random, solver (default solver)
+  -t, --threads <count>        Worker threads (default all cores)
+      --seed <seed>            Seed of the first board, the next ones add one each (default random)
+  -h, --help                   Show this message
+)";
+
+[[noreturn]] void exit_with_usage(const char *error);
+Options parse_options(int argc, char *argv[]);
+void add_difficulty(Options &options, const std::string &name);
+void add_custom(Options &options, const std::string &description);
+void print_report(const Simulator::Board &board, const Simulator::Report &report);
+
+int main(int argc, char *argv[]) {
+    using std::cout;
+    using std::setw;
+
+    const Options options = parse_options(argc, argv);
+    const Strategy::factory_t factory = Strategy::find_factory(options.strategy);
+
+    if (factory == nullptr)
+        exit_with_usage(("unknown strategy " + options.strategy).c_str());
+
+    WorkStealingPool pool(options.threads);
+    Simulator simulator(pool);
+
+    cout << "strategy " << options.strategy << ", " << options.games << " games per board, "
+            << pool.get_threads() << " threads, seed " << options.seed << std::endl;
+
+    cout << std::left << setw(20) << "board" << std::right
+            << setw(9) << "games" << setw(10) << "win %" << setw(10) << "stalled" << setw(12) << "games/s"
+            << setw(8) << "mean" << setw(6) << "p10" << setw(6) << "p50" << setw(6) << "p90" << setw(6) << "p99"
+            << setw(6) << "max" << std::endl;
+
+    for (size_t i = 0; i < options.boards.size(); i++) {
+        const Simulator::Board &board = options.boards[i];
+        const Simulator::Report report = simulator.run(board, options.games, factory, options.seed + i);
+        print_report(board, report);
+    }
+
+    return 0;
+}
+
+void exit_with_usage(const char *error) {
+    if (error != nullptr)
+        std::cerr << "minesweeper_sim: " << error << "\n\n";
+
+    (error != nullptr ? std::cerr : std::cout) << USAGE;
+    exit(error != nullptr ? 1 : 0);
+}
+
+Options parse_options(const int argc, char *argv[]) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char *option = argv[i];
+
+        if (strcmp(option, "-h") == 0 || strcmp(option, "--help") == 0)
+            exit_with_usage(nullptr);
+
+        if (i + 1 == argc)
+            exit_with_usage((std::string("missing value for ") + option).c_str());
+
+        const std::string value = argv[++i];
+
+        if (strcmp(option, "-n") == 0 || strcmp(option, "--games") == 0) {
+            options.games = atoi(value.c_str());
+            if (options.games <= 0)
+                exit_with_usage("games must be positive");
+        } else if (strcmp(option, "-d") == 0 || strcmp(option, "--difficulty") == 0) {
+            add_difficulty(options, value);
+        } else if (strcmp(option, "-c") == 0 || strcmp(option, "--custom") == 0) {
+            add_custom(options, value);
+        } else if (strcmp(option, "-s") == 0 || strcmp(option, "--strategy") == 0) {
+            options.strategy = value;
+        } else if (strcmp(option, "-t") == 0 || strcmp(option, "--threads") == 0) {
+            const int threads = atoi(value.c_str());
+            if (threads <= 0)
+                exit_with_usage("threads must be positive");
+
+            options.threads = threads;
+        } else if (strcmp(option, "--seed") == 0) {
+            options.seed = strtoull(value.c_str(), nullptr, 0);
+        } else {
+            exit_with_usage((std::string("unknown option ") + option).c_str());
+        }
+    }
+
+    if (options.boards.empty())
+        add_difficulty(options, "all");
+
+    return options;
+}
+
+void add_difficulty(Options &options, const std::string &name) {
+    bool found = false;
+
+    for (int i = 0; i < Game::DIFFICULTIES; i++) {
+        const std::string difficulty_name = Game::DIFFICULTY_NAMES[i];
+        const bool matches = std::equal(
+            name.begin(), name.end(), difficulty_name.begin(), difficulty_name.end(),
+            [](const char a, const char b) { return tolower(a) == tolower(b); }
+        );
+
+        if (name != "all" && !matches)
+            continue;
+
+        const auto &[rows, columns, mines] = Game::DIFFICULTY_TO_SETTING[i];
+        options.boards.push_back({Game::DIFFICULTY_NAMES[i], rows, columns, mines});
+        found = true;
+    }
+
+    if (!found)
+        exit_with_usage(("unknown difficulty " + name).c_str());
+}
+
+void add_custom(Options &options, const std::string &description) {
+    int rows, columns, mines;
+    char end;
+
+    if (sscanf(description.c_str(), "%dx%dx%d%c", &rows, &columns, &mines, &end) != 3
+        || rows <= 0 || columns <= 0 || mines < 0)
+        exit_with_usage(("invalid custom board " + description).c_str());
+
+    if (mines > MineSampler::max_mines(rows, columns))
+        exit_with_usage(("too many mines for custom board " + description).c_str());
+
+    options.boards.push_back({description, rows, columns, mines});
+}
+
+void print_report(const Simulator::Board &board, const Simulator::Report &report) {
+    using std::cout;
+    using std::setw;
+
+    cout << std::left << setw(20) << board.name << std::right
+            << setw(9) << report.games
+            << setw(10) << std::fixed << std::setprecision(2) << report.get_win_rate() * 100
+            << setw(10) << report.stalled
+            << setw(12) << std::setprecision(0) << report.get_games_per_second()
+            << setw(8) << std::setprecision(1) << report.get_reveals_mean()
+            << setw(6) << report.get_reveals_percentile(0.1)
+            << setw(6) << report.get_reveals_percentile(0.5)
+            << setw(6) << report.get_reveals_percentile(0.9)
+            << setw(6) << report.get_reveals_percentile(0.99)
+            << setw(6) << report.reveals.back() << std::endl;
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "strategy.hpp"
+#include "../core/game.hpp"
+#include "../core/random.hpp"
+#include "../core/work_stealing_pool.hpp"
+
+/**
+ * Plays batches of games without any rendering, sharded across a WorkStealingPool.
+ *
+ * Game i of a batch uses the i-th value of the batch seed as its own seed, so the results only depend on the seed
+ * and never on how the games were scheduled.
+ */
+class Simulator {
+public:
+    struct Board {
+        std::string name;
+        int rows;
+        int columns;
+        int mines;
+    };
+
+    struct Result {
+        bool won = false;
+        bool stalled = false;
+        int reveals = 0;
+    };
+
+    struct Report {
+        int games = 0;
+        int wins = 0;
+        // Games the strategy didn't finish within the move limit, counted as lost
+        int stalled = 0;
+        double seconds = 0;
+        // Sorted amount of reveal moves of every game
+        std::vector<int> reveals{};
+
+        [[nodiscard]] double get_win_rate() const {
+            return games == 0 ? 0 : static_cast<double>(wins) / games;
+        }
+
+        [[nodiscard]] double get_games_per_second() const {
+            return seconds == 0 ? 0 : games / seconds;
+        }
+
+        [[nodiscard]] int get_reveals_percentile(const double percentile) const {
+            if (reveals.empty())
+                return 0;
+
+            const auto rank = static_cast<size_t>(percentile * (reveals.size() - 1) + 0.5);
+            return reveals[rank];
+        }
+
+        [[nodiscard]] double get_reveals_mean() const {
+            double total = 0;
+
+            for (const int count : reveals)
+                total += count;
+
+            return reveals.empty() ? 0 : total / reveals.size();
+        }
+    };
+
+private:
+    // Games played by every task, small enough for stealing to even out the load
+    static constexpr int GAMES_PER_TASK = 16;
+    // Every move can at worst toggle a flag back and forth, so anything past this is a strategy stuck in a loop
+    static constexpr int MOVES_PER_CELL_LIMIT = 4;
+    // Tags the seed of the strategy stream, Game::clear_safe_zone() already uses mix(seed)
+    static constexpr uint64_t STRATEGY_STREAM_TAG = 0x5354524154454759; // "STRATEGY"
+
+    WorkStealingPool &m_pool;
+
+public:
+    explicit Simulator(WorkStealingPool &pool) : m_pool(pool) {}
+
+    Report run(const Board &board, const int games, const Strategy::factory_t factory, const uint64_t seed) {
+        using Clock = std::chrono::steady_clock;
+
+        const CounterRandom seeds(seed);
+        std::vector<Result> results(games);
+
+        const Clock::time_point start = Clock::now();
+
+        for (int first = 0; first < games; first += GAMES_PER_TASK) {
+            const int last = std::min(first + GAMES_PER_TASK, games);
+
+            m_pool.submit([&board, &results, &seeds, factory, first, last] {
+                const std::unique_ptr<Strategy> strategy = factory();
+
+                for (int i = first; i < last; i++)
+                    results[i] = play(board, *strategy, seeds.at(i));
+            });
+        }
+
+        m_pool.wait();
+
+        Report report;
+        report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        report.games = games;
+        report.reveals.reserve(games);
+
+        for (const auto &[won, stalled, reveals] : results) {
+            report.wins += won;
+            report.stalled += stalled;
+            report.reveals.push_back(reveals);
+        }
+
+        std::sort(report.reveals.begin(), report.reveals.end());
+
+        return report;
+    }
+
+    static Result play(const Board &board, Strategy &strategy, const uint64_t seed) {
+        Game game(board.rows, board.columns, board.mines, seed);
+        // Separate stream from the ones used for the mines and the safe zone
+        CounterRandom random(CounterRandom::mix(seed ^ STRATEGY_STREAM_TAG));
+        Result result;
+
+        strategy.start(game);
+
+        const int move_limit = board.rows * board.columns * MOVES_PER_CELL_LIMIT;
+
+        for (int moves = 0; !game.is_over(); moves++) {
+            if (moves == move_limit) {
+                result.stalled = true;
+                return result;
+            }
+
+            const auto [x, y, flag] = strategy.next_move(game, random);
+
+            if (flag) {
+                game.toggle_cell_flag(x, y);
+                continue;
+            }
+
+            if (!game.has_started())
+                game.place_grid_mines(x, y);
+
+            strategy.on_revealed(game.reveal_cell(x, y));
+            result.reveals++;
+        }
+
+        result.won = game.has_won();
+        return result;
+    }
+};
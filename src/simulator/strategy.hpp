@@ -0,0 +1,123 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../core/game.hpp"
+#include "../core/random.hpp"
+#include "../core/solver.hpp"
+
+/**
+ * Decides the next move of a simulated game, only from what a player can see on the board
+ */
+class Strategy {
+public:
+    struct Move {
+        int x = 0;
+        int y = 0;
+        bool flag = false;
+    };
+
+    typedef std::unique_ptr<Strategy> (*factory_t)();
+
+    struct Entry {
+        const char *name;
+        factory_t factory;
+    };
+
+    virtual ~Strategy() = default;
+
+    /**
+     * Called once before the first move of every game
+     */
+    virtual void start(const Game &game) {}
+
+    virtual Move next_move(const Game &game, CounterRandom &random) = 0;
+
+    /**
+     * Called with the cells revealed by every reveal move
+     */
+    virtual void on_revealed(const std::vector<Game::GridCoords> &revealed) {}
+
+    static const std::vector<Entry> &get_entries();
+
+    static factory_t find_factory(const std::string &name) {
+        for (const auto &[entry_name, factory] : get_entries())
+            if (name == entry_name)
+                return factory;
+
+        return nullptr;
+    }
+};
+
+/**
+ * Reveals a uniformly random hidden cell every move
+ */
+class RandomStrategy final : public Strategy {
+    std::vector<Move> m_candidates{};
+
+public:
+    Move next_move(const Game &game, CounterRandom &random) override {
+        m_candidates.clear();
+
+        for (int y = 0; y < game.get_rows(); y++)
+            for (int x = 0; x < game.get_columns(); x++) {
+                const Game::GridCell &cell = game.get_grid_cell(x, y);
+
+                if (!cell.revealed && !cell.flagged)
+                    m_candidates.push_back({x, y, false});
+            }
+
+        return m_candidates[random.uniform(0, static_cast<int>(m_candidates.size()) - 1)];
+    }
+};
+
+/**
+ * Opens in the middle of the board, then plays every cell the Solver proves safe, and only guesses a random
+ * unknown cell when it can't deduce anything
+ */
+class SolverStrategy final : public Strategy {
+    std::optional<Solver> m_solver{};
+    std::vector<Move> m_candidates{};
+
+public:
+    void start(const Game &game) override {
+        m_solver.emplace(game);
+    }
+
+    Move next_move(const Game &game, CounterRandom &random) override {
+        if (!game.has_started())
+            return {game.get_columns() / 2, game.get_rows() / 2, false};
+
+        const std::vector<int> &safe_cells = m_solver->get_safe_cells();
+
+        if (!safe_cells.empty()) {
+            const auto [x, y, inside] = m_solver->get_coords(safe_cells.back());
+            return {x, y, false};
+        }
+
+        m_candidates.clear();
+
+        for (int y = 0; y < game.get_rows(); y++)
+            for (int x = 0; x < game.get_columns(); x++)
+                if (m_solver->get_state(x, y) == Solver::STATE_UNKNOWN)
+                    m_candidates.push_back({x, y, false});
+
+        return m_candidates[random.uniform(0, static_cast<int>(m_candidates.size()) - 1)];
+    }
+
+    void on_revealed(const std::vector<Game::GridCoords> &revealed) override {
+        m_solver->update(revealed);
+    }
+};
+
+inline const std::vector<Strategy::Entry> &Strategy::get_entries() {
+    static const std::vector<Entry> entries = {
+        {"random", [] { return std::unique_ptr<Strategy>(std::make_unique<RandomStrategy>()); }},
+        {"solver", [] { return std::unique_ptr<Strategy>(std::make_unique<SolverStrategy>()); }},
+    };
+
+    return entries;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cmath>
 #include <iostream>
 #include <memory>
 #include <SDL.h>
@@ -7,9 +8,12 @@
 
 #include "../core/game.hpp"
 #include "../core/settings.hpp"
+#include "../graphics/atlas_cache.hpp"
 #include "../graphics/color.hpp"
 #include "../graphics/font.hpp"
+#include "../graphics/grid_layout.hpp"
 #include "../graphics/shape.hpp"
+#include "../graphics/text_label.hpp"
 #include "../graphics/texture.hpp"
 #include "../graphics/texture_bundle.hpp"
 
@@ -85,11 +89,19 @@ public:
         CELL_FLAG,
     };
 
-    enum TextureName {
+    enum SpriteName {
         H_GRID_LINE,
         V_GRID_LINE,
+        // Plain white, tinted by the vertex color
+        SOLID,
+    };
+
+    enum TextName {
         GAME_TIME_TEXT,
         REMAINING_MINES_TEXT,
+    };
+
+    enum TextureName {
         REMAINING_MINES_ICON,
         MOUSE_LEFT_ICON,
         MOUSE_LEFT_TEXT,
@@ -111,6 +123,24 @@ public:
 
     using GameTexture = std::shared_ptr<Texture>;
     using GameTextureBundle = std::shared_ptr<TextureBundle>;
+    using GameText = std::shared_ptr<TextLabel>;
+
+    /**
+     * Part of the atlas, and where it goes relative to the top left corner of its cell at the layout's cell size
+     */
+    struct Sprite {
+        SDL_Rect source;
+        SDL_Rect area;
+
+        [[nodiscard]] SDL_FRect get_destination(const float cell_x, const float cell_y, const float zoom) const {
+            return {
+                cell_x + area.x * zoom,
+                cell_y + area.y * zoom,
+                area.w * zoom,
+                area.h * zoom,
+            };
+        }
+    };
 
 private:
     struct CellTextureSetParameters {
@@ -123,6 +153,13 @@ private:
     static constexpr int CELL_TYPES = CELL_TRC + 1;
     static constexpr int CELL_SUBTYPES = CELL_FLAG + 1;
     static constexpr int CELL_TEXTURE_SIZE = 512;
+    static constexpr Font::Type CELL_NUMBER_FONT = Font::RUBIK_REGULAR;
+    // Bump whenever the atlas is drawn differently, so cached ones aren't used
+    static constexpr uint32_t ATLAS_DRAWING_VERSION = 1;
+    // Every cell set, the numbers and the SpriteNames
+    static constexpr int ATLAS_SPRITES = CELL_SUBTYPES * CELL_TYPES + 8 + SOLID + 1;
+    // Transparent pixels around each sprite, so scaled sprites don't sample their neighbours
+    static constexpr int ATLAS_PADDING = 1;
 
     static constexpr auto CELL_MAP_IMAGE_PATH = "assets/textures/cell_map.png";
     static constexpr auto MINE_IMAGE_PATH = "assets/textures/mine.png";
@@ -134,6 +171,13 @@ private:
     static constexpr double ACTION_TOGGLE_THICKNESS_FACTOR = 1.0 / 32;
     static constexpr double BACK_BUTTON_THICKNESS_FACTOR = 1.0 / 8;
     static constexpr double MOUSE_ICON_THICKNESS_FACTOR = 1.0 / 8;
+    // Relative to the window width
+    static constexpr double ACTION_TOGGLE_WIDTH_FACTOR = 0.04;
+    // Relative to the action toggle width
+    static constexpr double ACTION_TOGGLE_BUTTON_FACTOR = 0.78;
+    // Relative to the action toggle buttons
+    static constexpr float ACTION_TOGGLE_FLAG_SCALE = 0.45;
+    static constexpr float ACTION_TOGGLE_MINE_SCALE = 0.6;
 
     static constexpr CellTextureSetParameters CELL_TEXTURE_SET_PARAMETERS[CELL_SUBTYPES] = {
         {Color::THEME, nullptr, 0, Color::BACKGROUND},
@@ -143,8 +187,14 @@ private:
         {Color::FLAGGED_CELL, FLAG_IMAGE_PATH, 0.35, Color::FLAG},
     };
 
+    struct AtlasSprites {
+        Sprite cells[CELL_SUBTYPES][CELL_TYPES];
+        Sprite cell_numbers[8];
+        Sprite named[SOLID + 1];
+    };
+
     SDL_Renderer *m_renderer;
-    const Game::Measurements &m_measurements;
+    const GridLayout::Measurements m_measurements;
     const Game::Difficulty m_game_difficulty;
     const int m_window_width;
     const int m_window_height;
@@ -152,14 +202,14 @@ private:
 
     Font m_game_over_font;
 
-    GameTexture m_h_grid_line_texture;
-    GameTexture m_v_grid_line_texture;
+    GameTexture m_atlas_texture;
+    int m_atlas_columns = 0;
+    int m_atlas_slots = 0;
+    // Saved along with the atlas pixels, see AtlasCache
+    AtlasSprites m_atlas_sprites{};
 
-    GameTexture m_cell_textures[CELL_SUBTYPES][CELL_TYPES];
-    GameTexture m_cell_numbers_textures[8];
-
-    GameTexture m_game_time_text_texture;
-    GameTexture m_remaining_mines_text_texture;
+    GameText m_game_time_text;
+    GameText m_remaining_mines_text;
     GameTexture m_remaining_mines_icon_texture;
 
     GameTexture m_action_toggle_texture;
@@ -182,7 +232,7 @@ private:
 public:
     GameTextureManager(
         SDL_Renderer *renderer,
-        const Game::Measurements &measurements,
+        const GridLayout::Measurements &measurements,
         const Game::Difficulty difficulty,
         const int window_width,
         const int window_height
@@ -193,11 +243,21 @@ public:
         m_window_height(window_height),
         m_window_padding(window_height * 0.025),
         m_game_over_font(Font::RUBIK_REGULAR, window_height * 0.03) {
-        make_grid_lines_textures();
-        make_cell_numbers_textures();
+        const AtlasCache::Key atlas_key = make_atlas_key(m_measurements);
+
+        m_atlas_texture = AtlasCache::load(m_renderer, atlas_key, &m_atlas_sprites, sizeof(m_atlas_sprites));
+
+        if (m_atlas_texture == nullptr) {
+            make_atlas_texture();
+            make_grid_lines_sprites();
+            make_cell_numbers_sprites();
+            make_cell_sprites();
+            AtlasCache::save(m_renderer, atlas_key, &m_atlas_sprites, sizeof(m_atlas_sprites), *m_atlas_texture);
+        }
+
         make_back_button_texture();
         make_remaining_mines_textures();
-        make_game_time_texture();
+        make_game_time_text();
         make_click_to_start_texture();
         make_game_lost_texture_bundle();
         make_game_won_texture_bundle();
@@ -207,49 +267,124 @@ public:
 
         if (Settings::is_on(Settings::SINGLE_CLICK_CONTROLS))
             make_action_toggle_textures();
+    }
 
-        const auto cell_map_texture = std::make_shared<Texture>(m_renderer, CELL_MAP_IMAGE_PATH);
+    ~GameTextureManager() = default;
 
-        for (int cell_subtype = 0; cell_subtype < CELL_SUBTYPES; cell_subtype++) {
-            const auto &[
-                cell_color,
-                image_path,
-                image_scale_respect_to_cell,
-                image_color
-            ] = CELL_TEXTURE_SET_PARAMETERS[cell_subtype];
+    /**
+     * Starts loading the images a manager with these measurements uses, see AssetLoader. Must match the make_*
+     * functions.
+     */
+    static void request_assets(
+        const GridLayout::Measurements &measurements,
+        const int window_width,
+        const int window_height
+    ) {
+        AssetLoader::request_image(MINE_IMAGE_PATH, {0, Font::get_shared_size(Font::PRIMARY, window_height)});
 
-            make_cell_textures_set(
-                static_cast<CellSubtype>(cell_subtype),
-                cell_map_texture,
-                cell_color,
-                image_path,
-                image_scale_respect_to_cell,
-                image_color
+        if (!AtlasCache::contains(make_atlas_key(measurements))) {
+            AssetLoader::request_image(CELL_MAP_IMAGE_PATH);
+
+            for (const auto &[cell_color, image_path, image_scale, image_color] : CELL_TEXTURE_SET_PARAMETERS) {
+                if (image_path == nullptr)
+                    continue;
+
+                const int image_size = get_cell_image_size(measurements.cell_size, image_scale);
+                AssetLoader::request_image(image_path, {image_size, image_size});
+            }
+        }
+
+        if (Settings::is_on(Settings::SINGLE_CLICK_CONTROLS)) {
+            const int button_size = get_action_toggle_button_size(window_width);
+
+            AssetLoader::request_image(
+                FLAG_IMAGE_PATH,
+                {0, get_action_toggle_image_size(button_size, ACTION_TOGGLE_FLAG_SCALE)}
+            );
+            AssetLoader::request_image(
+                MINE_IMAGE_PATH,
+                {0, get_action_toggle_image_size(button_size, ACTION_TOGGLE_MINE_SCALE)}
             );
         }
     }
 
-    ~GameTextureManager() = default;
+    /**
+     * Managers made with the same key are the same, see ResourceCache. Covers the settings the textures depend on.
+     */
+    [[nodiscard]] static std::string make_cache_key(
+        const GridLayout::Measurements &measurements,
+        const Game::Difficulty difficulty,
+        const int window_width,
+        const int window_height
+    ) {
+        return "game " + std::to_string(window_width) + 'x' + std::to_string(window_height)
+                + ' ' + std::to_string(difficulty)
+                + ' ' + std::to_string(measurements.cell_size)
+                + ' ' + std::to_string(measurements.grid_line_length)
+                + ' ' + std::to_string(measurements.grid_line_width)
+                + ' ' + std::to_string(Settings::is_on(Settings::SHOW_CONTROLS))
+                + std::to_string(Settings::is_on(Settings::SWAP_CONTROLS))
+                + std::to_string(Settings::is_on(Settings::SINGLE_CLICK_CONTROLS));
+    }
+
+    /**
+     * Text labels aren't counted, their glyphs belong to the shared fonts
+     */
+    [[nodiscard]] size_t get_memory_size() const {
+        size_t size = 0;
+
+        for (const GameTextureBundle &bundle : {m_game_lost_texture_bundle, m_game_won_texture_bundle})
+            if (bundle != nullptr)
+                size += bundle->get_memory_size();
+
+        // Some are only made with their setting on
+        for (const GameTexture &texture : {
+                 m_atlas_texture,
+                 m_remaining_mines_icon_texture,
+                 m_action_toggle_texture,
+                 m_action_toggle_mine_texture,
+                 m_action_toggle_mine_selected_texture,
+                 m_action_toggle_flag_texture,
+                 m_action_toggle_flag_selected_texture,
+                 m_mouse_left_icon_texture,
+                 m_mouse_left_text_texture,
+                 m_mouse_right_icon_texture,
+                 m_mouse_right_text_texture,
+                 m_back_button_texture,
+                 m_click_to_start_texture,
+             })
+            if (texture != nullptr)
+                size += texture->get_memory_size();
+
+        return size;
+    }
+
+    /**
+     * Texture every Sprite is cut from
+     */
+    [[nodiscard]] const Texture &get_atlas() const {
+        return *m_atlas_texture;
+    }
 
-    [[nodiscard]] GameTexture get(const CellSubtype subtype, const CellType type) const {
-        return m_cell_textures[subtype][type];
+    [[nodiscard]] const Sprite &get(const CellSubtype subtype, const CellType type) const {
+        return m_atlas_sprites.cells[subtype][type];
     }
 
-    [[nodiscard]] GameTexture get(const int cell_number) const {
+    [[nodiscard]] const Sprite &get(const int cell_number) const {
         if (cell_number < 0 || cell_number > 7) {
             std::cerr << "Number must be between 0 and 7 inclusive." << std::endl;
             exit(1);
         }
 
-        return m_cell_numbers_textures[cell_number];
+        return m_atlas_sprites.cell_numbers[cell_number];
+    }
+
+    [[nodiscard]] const Sprite &get(const SpriteName name) const {
+        return m_atlas_sprites.named[name];
     }
 
     [[nodiscard]] GameTexture get(const TextureName name) const {
         switch (name) {
-            case H_GRID_LINE: return m_h_grid_line_texture;
-            case V_GRID_LINE: return m_v_grid_line_texture;
-            case GAME_TIME_TEXT: return m_game_time_text_texture;
-            case REMAINING_MINES_TEXT: return m_remaining_mines_text_texture;
             case REMAINING_MINES_ICON: return m_remaining_mines_icon_texture;
             case MOUSE_LEFT_ICON: return m_mouse_left_icon_texture;
             case MOUSE_LEFT_TEXT: return m_mouse_left_text_texture;
@@ -266,6 +401,14 @@ public:
         __builtin_unreachable();
     }
 
+    [[nodiscard]] GameText get(const TextName name) const {
+        switch (name) {
+            case GAME_TIME_TEXT: return m_game_time_text;
+            case REMAINING_MINES_TEXT: return m_remaining_mines_text;
+        }
+        __builtin_unreachable();
+    }
+
     [[nodiscard]] GameTextureBundle get(const TextureBundleName name) const {
         switch (name) {
             case GAME_LOST: return m_game_lost_texture_bundle;
@@ -275,7 +418,110 @@ public:
     }
 
 private:
-    void make_cell_textures_set(
+    static int get_cell_image_size(const int cell_size, const float image_scale_respect_to_cell) {
+        return cell_size * image_scale_respect_to_cell;
+    }
+
+    static int get_action_toggle_width(const int window_width) {
+        return window_width * ACTION_TOGGLE_WIDTH_FACTOR;
+    }
+
+    static int get_action_toggle_button_size(const int window_width) {
+        return get_action_toggle_width(window_width) * ACTION_TOGGLE_BUTTON_FACTOR;
+    }
+
+    static int get_action_toggle_image_size(const int button_size, const float image_scale_respect_to_toggle) {
+        return button_size * image_scale_respect_to_toggle;
+    }
+
+    /**
+     * Hash of everything the atlas is drawn from
+     */
+    [[nodiscard]] static AtlasCache::Key make_atlas_key(const GridLayout::Measurements &measurements) {
+        AtlasCache::Key key;
+
+        key.add(ATLAS_DRAWING_VERSION)
+                .add(ATLAS_PADDING)
+                .add(measurements.cell_size)
+                .add(measurements.grid_line_length)
+                .add(measurements.grid_line_width);
+
+        for (int color = 0; color <= Color::WHITE; color++)
+            key.add(Color::get(static_cast<Color::Name>(color)).get_rgb());
+
+        for (const auto &[cell_color, image_path, image_scale, image_color] : CELL_TEXTURE_SET_PARAMETERS)
+            key.add(cell_color).add_string(image_path).add(image_scale).add(image_color);
+
+        key.add_file(CELL_MAP_IMAGE_PATH)
+                .add_file(MINE_IMAGE_PATH)
+                .add_file(FLAG_IMAGE_PATH)
+                .add_file(Font::get_path(CELL_NUMBER_FONT));
+
+        return key;
+    }
+
+    /**
+     * Empty square atlas with a slot for each sprite, filled by the make_*_sprites functions
+     */
+    void make_atlas_texture() {
+        const int slot_size = m_measurements.cell_size + ATLAS_PADDING * 2;
+
+        m_atlas_columns = static_cast<int>(std::ceil(std::sqrt(ATLAS_SPRITES)));
+        m_atlas_texture = std::make_shared<Texture>(
+            m_renderer,
+            SDL_Rect{0, 0, m_atlas_columns * slot_size, m_atlas_columns * slot_size}
+        );
+
+        const Texture::ScopedRender scoped_render = m_atlas_texture->set_as_render_target();
+
+        SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 0);
+        SDL_RenderClear(m_renderer);
+    }
+
+    /**
+     * Copies a texture as is into the next slot of the atlas
+     */
+    Sprite add_sprite(const Texture &texture, const SDL_Rect &area) {
+        const int slot_size = m_measurements.cell_size + ATLAS_PADDING * 2;
+        const int slot = m_atlas_slots++;
+        const SDL_Rect source = {
+            slot % m_atlas_columns * slot_size + ATLAS_PADDING,
+            slot / m_atlas_columns * slot_size + ATLAS_PADDING,
+            area.w,
+            area.h,
+        };
+
+        const Texture::ScopedRender scoped_render = m_atlas_texture->set_as_render_target();
+
+        texture.set_blend_mode(SDL_BLENDMODE_NONE);
+        texture.render_to(source);
+
+        return {source, area};
+    }
+
+    void make_cell_sprites() {
+        const auto cell_map_texture = std::make_shared<Texture>(m_renderer, CELL_MAP_IMAGE_PATH);
+
+        for (int cell_subtype = 0; cell_subtype < CELL_SUBTYPES; cell_subtype++) {
+            const auto &[
+                cell_color,
+                image_path,
+                image_scale_respect_to_cell,
+                image_color
+            ] = CELL_TEXTURE_SET_PARAMETERS[cell_subtype];
+
+            make_cell_sprites_set(
+                static_cast<CellSubtype>(cell_subtype),
+                cell_map_texture,
+                cell_color,
+                image_path,
+                image_scale_respect_to_cell,
+                image_color
+            );
+        }
+    }
+
+    void make_cell_sprites_set(
         const CellSubtype cell_subtype,
         const GameTexture &cell_map_texture,
         const Color::Name cell_color,
@@ -285,7 +531,7 @@ private:
     ) {
         const int cell_size = m_measurements.cell_size;
         const int grid_line_width = m_measurements.grid_line_width;
-        const int image_size = cell_size * image_scale_respect_to_cell;
+        const int image_size = get_cell_image_size(cell_size, image_scale_respect_to_cell);
         const int image_offset = (grid_line_width + cell_size - image_size) / 2;
 
         const SDL_Rect texture_area = {0, 0, cell_size, cell_size};
@@ -305,8 +551,8 @@ private:
         cell_map_texture->set_color(cell_color);
 
         for (int type = 0; type < CELL_TYPES; type++) {
-            const auto cell_texture = std::make_shared<Texture>(m_renderer, texture_area);
-            const Texture::ScopedRender scoped_render = cell_texture->set_as_render_target();
+            const Texture cell_texture(m_renderer, texture_area);
+            const Texture::ScopedRender scoped_render = cell_texture.set_as_render_target();
 
             const int map_index = type * CELL_TEXTURE_SIZE;
             const int map_x = map_index % cell_map_texture->get_w();
@@ -317,38 +563,39 @@ private:
             if (image_path != nullptr)
                 image_texture->render();
 
-            m_cell_textures[cell_subtype][type] = cell_texture;
+            scoped_render.release();
+            m_atlas_sprites.cells[cell_subtype][type] = add_sprite(cell_texture, texture_area);
         }
 
         cell_map_texture->set_color(Color::WHITE);
     }
 
-    void make_cell_numbers_textures() {
+    void make_cell_numbers_sprites() {
         const int cell_size = m_measurements.cell_size;
         const int grid_line_width = m_measurements.grid_line_width;
 
-        const Font cell_number_font(Font::RUBIK_REGULAR, m_measurements.cell_size * 0.5);
+        const Font cell_number_font(CELL_NUMBER_FONT, m_measurements.cell_size * 0.5);
 
         for (int cell = 0; cell < 8; cell++) {
             const char cell_text[2] = {static_cast<char>('0' + cell + 1), 0};
 
-            const auto cell_number_texture = std::make_shared<Texture>(
+            Texture cell_number_texture(
                 m_renderer,
                 cell_number_font.get_raw(),
                 cell_text,
                 static_cast<Color::Name>(Color::GRID_1 + cell)
             );
 
-            cell_number_texture->set_position(
-                (grid_line_width + cell_size - cell_number_texture->get_w()) / 2,
-                (grid_line_width + cell_size - cell_number_texture->get_h()) / 2
+            cell_number_texture.set_position(
+                (grid_line_width + cell_size - cell_number_texture.get_w()) / 2,
+                (grid_line_width + cell_size - cell_number_texture.get_h()) / 2
             );
 
-            m_cell_numbers_textures[cell] = cell_number_texture;
+            m_atlas_sprites.cell_numbers[cell] = add_sprite(cell_number_texture, cell_number_texture.get_area());
         }
     }
 
-    void make_grid_lines_textures() {
+    void make_grid_lines_sprites() {
         const auto &[
             cell_size,
             grid_line_length,
@@ -362,12 +609,12 @@ private:
         const int grid_line_offset = (grid_line_width + cell_size - grid_line_length) / 2;
         const float thickness_2 = grid_line_width / 2.0f;
 
-        m_h_grid_line_texture = std::make_shared<Texture>(
+        const Texture h_grid_line_texture(
             m_renderer,
             SDL_Rect{grid_line_offset, -static_cast<int>(thickness_2), grid_line_length, grid_line_width}
         );
 
-        const Texture::ScopedRender h_grid_line_renderer = m_h_grid_line_texture->set_as_render_target();
+        const Texture::ScopedRender h_grid_line_renderer = h_grid_line_texture.set_as_render_target();
 
         Shape::rounded_line(
             m_renderer,
@@ -380,13 +627,14 @@ private:
         );
 
         h_grid_line_renderer.release();
+        m_atlas_sprites.named[H_GRID_LINE] = add_sprite(h_grid_line_texture, h_grid_line_texture.get_area());
 
-        m_v_grid_line_texture = std::make_shared<Texture>(
+        const Texture v_grid_line_texture(
             m_renderer,
             SDL_Rect{-static_cast<int>(thickness_2), grid_line_offset, grid_line_width, grid_line_length}
         );
 
-        const Texture::ScopedRender v_grid_line_renderer = m_v_grid_line_texture->set_as_render_target();
+        const Texture::ScopedRender v_grid_line_renderer = v_grid_line_texture.set_as_render_target();
 
         Shape::rounded_line(
             m_renderer,
@@ -397,6 +645,17 @@ private:
             grid_line_width,
             Color::GREY
         );
+
+        v_grid_line_renderer.release();
+        m_atlas_sprites.named[V_GRID_LINE] = add_sprite(v_grid_line_texture, v_grid_line_texture.get_area());
+
+        const Texture solid_texture(m_renderer, SDL_Rect{0, 0, cell_size, cell_size});
+        const Texture::ScopedRender solid_renderer = solid_texture.set_as_render_target();
+
+        Shape::filled_rectangle(m_renderer, solid_texture.get_area(), Color::WHITE);
+
+        solid_renderer.release();
+        m_atlas_sprites.named[SOLID] = add_sprite(solid_texture, solid_texture.get_area());
     }
 
     void make_back_button_texture() {
@@ -442,12 +701,11 @@ private:
     void make_remaining_mines_textures() {
         const int icon_size = Font::get_shared(Font::PRIMARY)->get_size();
 
-        m_remaining_mines_icon_texture = std::make_shared<Texture>(m_renderer, MINE_IMAGE_PATH);
-        m_remaining_mines_icon_texture->set_height(icon_size);
+        m_remaining_mines_icon_texture = std::make_shared<Texture>(m_renderer, MINE_IMAGE_PATH, icon_size);
 
-        m_remaining_mines_text_texture = std::make_shared<Texture>(
+        m_remaining_mines_text = std::make_shared<TextLabel>(
             m_renderer,
-            Font::get_shared(Font::PRIMARY)->get_raw(),
+            *Font::get_shared(Font::PRIMARY),
             "0",
             Color::WHITE
         );
@@ -455,26 +713,26 @@ private:
         const int text_x_offset = icon_size + 10;
 
         m_remaining_mines_icon_texture->set_position(
-            (m_window_width - text_x_offset - m_remaining_mines_text_texture->get_w()) / 2,
+            (m_window_width - text_x_offset - m_remaining_mines_text->get_w()) / 2,
             m_window_padding
         );
 
-        m_remaining_mines_text_texture->set_position(
+        m_remaining_mines_text->set_position(
             m_remaining_mines_icon_texture->get_x() + text_x_offset,
-            m_remaining_mines_icon_texture->get_y() + (icon_size - m_remaining_mines_text_texture->get_h()) / 2
+            m_remaining_mines_icon_texture->get_y() + (icon_size - m_remaining_mines_text->get_h()) / 2
         );
     }
 
-    void make_game_time_texture() {
-        m_game_time_text_texture = std::make_shared<Texture>(
+    void make_game_time_text() {
+        m_game_time_text = std::make_shared<TextLabel>(
             m_renderer,
-            Font::get_shared(Font::SECONDARY)->get_raw(),
+            *Font::get_shared(Font::SECONDARY),
             "0",
             Color::LIGHTER_GREY
         );
 
-        m_game_time_text_texture->set_position(
-            (m_window_width - m_game_time_text_texture->get_w()) / 2,
+        m_game_time_text->set_position(
+            (m_window_width - m_game_time_text->get_w()) / 2,
             m_remaining_mines_icon_texture->get_y() + m_remaining_mines_icon_texture->get_h() + m_window_padding / 2
         );
     }
@@ -547,7 +805,7 @@ private:
     }
 
     void make_action_toggle_textures() {
-        const int action_toggle_width = m_window_width * 0.04;
+        const int action_toggle_width = get_action_toggle_width(m_window_width);
         const int action_toggle_height = action_toggle_width * 2;
         const int action_toggle_x = m_window_width - action_toggle_width - m_window_padding;
         const int action_toggle_y = m_window_height - action_toggle_height - m_window_padding;
@@ -569,7 +827,7 @@ private:
 
         action_toggle_texture_renderer.release();
 
-        const int toggle_size = action_toggle_width * 0.78;
+        const int toggle_size = get_action_toggle_button_size(m_window_width);
         const int toggle_padding = (action_toggle_width - toggle_size) / 2;
         const int toggle_x = action_toggle_x + toggle_padding;
 
@@ -577,7 +835,7 @@ private:
             m_action_toggle_flag_texture,
             m_action_toggle_flag_selected_texture,
             FLAG_IMAGE_PATH,
-            0.45,
+            ACTION_TOGGLE_FLAG_SCALE,
             toggle_size,
             toggle_x,
             action_toggle_y + toggle_padding
@@ -587,7 +845,7 @@ private:
             m_action_toggle_mine_texture,
             m_action_toggle_mine_selected_texture,
             MINE_IMAGE_PATH,
-            0.6,
+            ACTION_TOGGLE_MINE_SCALE,
             toggle_size,
             toggle_x,
             action_toggle_y + action_toggle_height - toggle_size - toggle_padding
@@ -603,8 +861,11 @@ private:
         const int x,
         const int y
     ) {
-        Texture image_texture(m_renderer, image_path);
-        image_texture.set_height(size * image_scale_respect_to_toggle);
+        Texture image_texture(
+            m_renderer,
+            image_path,
+            get_action_toggle_image_size(size, image_scale_respect_to_toggle)
+        );
         image_texture.set_position((size - image_texture.get_w()) / 2, (size - image_texture.get_h()) / 2);
 
         toggle_texture = std::make_shared<Texture>(m_renderer, SDL_Rect{x, y, size, size});
@@ -683,6 +944,10 @@ private:
         );
         m_game_lost_texture_bundle->add(game_over_text_texture);
 
+        // Custom and infinite boards have no difficulty name
+        if (m_game_difficulty >= Game::DIFFICULTIES)
+            return;
+
         const auto game_difficulty_text_texture = std::make_shared<Texture>(
             m_renderer,
             Font::get_shared(Font::SECONDARY)->get_raw(),
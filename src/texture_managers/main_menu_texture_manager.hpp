@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <SDL.h>
+#include <string>
 
 #include "../core/game.hpp"
 #include "../graphics/color.hpp"
@@ -16,6 +17,9 @@ public:
         TITLE,
         NEW_GAME_BUTTON,
         CONTINUE_GAME_BUTTON,
+        NO_GUESS_OFF_TOGGLE,
+        NO_GUESS_ON_TOGGLE,
+        INFINITE_BUTTON,
         LEFT_ARROW,
         RIGHT_ARROW,
         SETTINGS_BUTTON,
@@ -46,6 +50,9 @@ private:
 
     MainMenuTexture m_new_game_button_texture;
     MainMenuTexture m_continue_game_button_texture;
+    MainMenuTexture m_no_guess_off_toggle_texture;
+    MainMenuTexture m_no_guess_on_toggle_texture;
+    MainMenuTexture m_infinite_button_texture;
 
     MainMenuTexture m_left_arrow_texture;
     MainMenuTexture m_right_arrow_texture;
@@ -66,18 +73,64 @@ public:
         make_bottom_buttons();
         make_new_game_button();
         make_continue_game_button();
+        make_no_guess_toggles();
+        make_infinite_button();
         make_difficulty_buttons();
         make_difficulty_textures();
     }
 
     ~MainMenuTextureManager() = default;
 
+    /**
+     * Starts loading the images a manager for this window uses, see AssetLoader
+     */
+    static void request_assets(const int window_height) {
+        const int big_mine_size = get_big_mine_size(window_height);
+
+        AssetLoader::request_image(BIG_MINE_IMAGE_PATH, {big_mine_size, big_mine_size});
+        AssetLoader::request_image(SETTINGS_BUTTON_IMAGE_PATH, {0, get_bottom_buttons_height(window_height)});
+    }
+
+    /**
+     * Managers made with the same key are the same, see ResourceCache
+     */
+    [[nodiscard]] static std::string make_cache_key(const int window_width, const int window_height) {
+        return "main_menu " + std::to_string(window_width) + 'x' + std::to_string(window_height);
+    }
+
+    [[nodiscard]] size_t get_memory_size() const {
+        size_t size = 0;
+
+        for (const MainMenuTexture &texture : {
+                 m_big_mine_texture,
+                 m_title_texture,
+                 m_new_game_button_texture,
+                 m_continue_game_button_texture,
+                 m_no_guess_off_toggle_texture,
+                 m_no_guess_on_toggle_texture,
+                 m_infinite_button_texture,
+                 m_left_arrow_texture,
+                 m_right_arrow_texture,
+                 m_quit_button_texture,
+                 m_settings_button_texture,
+             })
+            size += texture->get_memory_size();
+
+        for (const MainMenuTexture &texture : m_difficulty_textures)
+            size += texture->get_memory_size();
+
+        return size;
+    }
+
     [[nodiscard]] MainMenuTexture get(const TextureName name) const {
         switch (name) {
             case BIG_MINE: return m_big_mine_texture;
             case TITLE: return m_title_texture;
             case NEW_GAME_BUTTON: return m_new_game_button_texture;
             case CONTINUE_GAME_BUTTON: return m_continue_game_button_texture;
+            case NO_GUESS_OFF_TOGGLE: return m_no_guess_off_toggle_texture;
+            case NO_GUESS_ON_TOGGLE: return m_no_guess_on_toggle_texture;
+            case INFINITE_BUTTON: return m_infinite_button_texture;
             case LEFT_ARROW: return m_left_arrow_texture;
             case RIGHT_ARROW: return m_right_arrow_texture;
             case SETTINGS_BUTTON: return m_settings_button_texture;
@@ -91,9 +144,17 @@ public:
     }
 
 private:
+    static int get_big_mine_size(const int window_height) {
+        return window_height * 0.25;
+    }
+
+    static int get_bottom_buttons_height(const int window_height) {
+        return Font::get_shared_size(Font::PRIMARY, window_height) * 1.5;
+    }
+
     void make_big_mine_texture() {
         const int y = m_window_height * 0.1;
-        const int size = m_window_height * 0.25;
+        const int size = get_big_mine_size(m_window_height);
         const int x = (m_window_width - size) / 2;
 
         m_big_mine_texture = std::make_shared<Texture>(
@@ -199,6 +260,40 @@ private:
         text_texture.render();
     }
 
+    void make_no_guess_toggles() {
+        const Font::Shared font = Font::get_shared(Font::PRIMARY);
+        const int y = m_continue_game_button_texture->get_y() + m_continue_game_button_texture->get_h() * 1.5;
+
+        m_no_guess_off_toggle_texture = std::make_shared<Texture>(
+            m_renderer,
+            font->get_raw(),
+            "No guessing: Off",
+            Color::LIGHTER_GREY
+        );
+        m_no_guess_off_toggle_texture->set_position((m_window_width - m_no_guess_off_toggle_texture->get_w()) / 2, y);
+
+        m_no_guess_on_toggle_texture = std::make_shared<Texture>(
+            m_renderer,
+            font->get_raw(),
+            "No guessing: On",
+            Color::WHITE
+        );
+        m_no_guess_on_toggle_texture->set_position((m_window_width - m_no_guess_on_toggle_texture->get_w()) / 2, y);
+    }
+
+    void make_infinite_button() {
+        m_infinite_button_texture = std::make_shared<Texture>(
+            m_renderer,
+            Font::get_shared(Font::PRIMARY)->get_raw(),
+            "Infinite board",
+            Color::WHITE
+        );
+        m_infinite_button_texture->set_position(
+            (m_window_width - m_infinite_button_texture->get_w()) / 2,
+            m_no_guess_off_toggle_texture->get_y() + m_no_guess_off_toggle_texture->get_h() * 1.5
+        );
+    }
+
     void make_difficulty_buttons() {
         const Font::Shared font = Font::get_shared(Font::PRIMARY);
         const int button_width = m_new_game_button_texture->get_w();
@@ -292,10 +387,9 @@ private:
     }
 
     void make_bottom_buttons() {
-        const int height = Font::get_shared(Font::PRIMARY)->get_size() * 1.5;
+        const int height = get_bottom_buttons_height(m_window_height);
 
-        m_settings_button_texture = std::make_shared<Texture>(m_renderer, SETTINGS_BUTTON_IMAGE_PATH);
-        m_settings_button_texture->set_height(height);
+        m_settings_button_texture = std::make_shared<Texture>(m_renderer, SETTINGS_BUTTON_IMAGE_PATH, height);
         m_settings_button_texture->set_position(
             (m_window_width - m_settings_button_texture->get_w()) / 2,
             m_window_height - height - m_window_padding
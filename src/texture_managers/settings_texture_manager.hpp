@@ -100,6 +100,30 @@ public:
 
     ~SettingsTextureManager() = default;
 
+    /**
+     * Managers made with the same key are the same, see ResourceCache
+     */
+    [[nodiscard]] static std::string make_cache_key(const int window_width, const int window_height) {
+        return "settings " + std::to_string(window_width) + 'x' + std::to_string(window_height);
+    }
+
+    [[nodiscard]] size_t get_memory_size() const {
+        size_t size = 0;
+
+        for (const SettingsTexture &texture : {
+                 m_back_button_texture,
+                 m_scrollbar_texture,
+                 m_toggle_off_texture,
+                 m_toggle_on_texture,
+             })
+            size += texture->get_memory_size();
+
+        for (const SettingsTextureBundle &bundle : m_text_textures_bundles)
+            size += bundle->get_memory_size();
+
+        return size;
+    }
+
     [[nodiscard]] SettingsTexture get(const TextureName name) const {
         switch (name) {
             case BACK_BUTTON: return m_back_button_texture;